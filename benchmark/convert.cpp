@@ -0,0 +1,111 @@
+#include "data.hpp"
+
+#include <text_processing/convert.hpp>
+#include <text_processing/join.hpp>
+
+#include <charconv>
+
+namespace {
+
+std::vector<std::string> numbers(size_t count)
+{
+    std::mt19937 gen(1337);
+    std::uniform_int_distribution<int> value(-1'000'000, 1'000'000);
+    std::vector<std::string> result;
+    result.reserve(count);
+    for (size_t idx = 0; idx < count; ++idx)
+        result.push_back(std::to_string(value(gen)));
+    return result;
+}
+
+void ConvertInts(benchmark::State& state)
+{
+    auto input = numbers(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Text::convert<int>(input));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(ConvertInts)->Arg(1 << 10)->Arg(1 << 16);
+
+// Fixed width digit fields like millisecond timestamps
+void ConvertTimestamps(benchmark::State& state)
+{
+    std::mt19937 gen(1337);
+    std::uniform_int_distribution<int64_t> value(1'600'000'000'000, 1'800'000'000'000);
+    std::vector<std::string> input;
+    for (int64_t idx = 0; idx < state.range(0); ++idx)
+        input.push_back(std::to_string(value(gen)));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Text::convert<int64_t>(input));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(ConvertTimestamps)->Arg(1 << 10)->Arg(1 << 16);
+
+void ConvertInt(benchmark::State& state)
+{
+    std::string input("-123456");
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Text::convert<int>(input));
+}
+BENCHMARK(ConvertInt);
+
+void ConvertDoubles(benchmark::State& state)
+{
+    auto input = numbers(static_cast<size_t>(state.range(0)));
+    for (auto& number : input)
+        number += ".125";
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Text::convert<double>(input));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(ConvertDoubles)->Arg(1 << 10)->Arg(1 << 16);
+
+void StdFromChars(benchmark::State& state)
+{
+    auto input = numbers(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        std::vector<int> result;
+        result.reserve(input.size());
+        for (const auto& number : input)
+        {
+            int value = 0;
+            std::from_chars(number.data(), number.data() + number.size(), value);
+            result.push_back(value);
+        }
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(StdFromChars)->Arg(1 << 10)->Arg(1 << 16);
+
+// Row of numbers serialized as CSV
+void JoinNumbers(benchmark::State& state)
+{
+    std::vector<int> values;
+    for (const auto& number : numbers(static_cast<size_t>(state.range(0))))
+        values.push_back(std::stoi(number));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Text::join_numbers(values, ','));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(JoinNumbers)->Arg(1 << 10)->Arg(1 << 16);
+
+void ToStringJoin(benchmark::State& state)
+{
+    std::vector<int> values;
+    for (const auto& number : numbers(static_cast<size_t>(state.range(0))))
+        values.push_back(std::stoi(number));
+    for (auto _ : state)
+    {
+        std::vector<std::string> strings;
+        strings.reserve(values.size());
+        for (auto value : values)
+            strings.push_back(std::to_string(value));
+        benchmark::DoNotOptimize(Text::join(strings, ','));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(ToStringJoin)->Arg(1 << 10)->Arg(1 << 16);
+
+} // namespace
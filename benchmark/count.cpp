@@ -0,0 +1,75 @@
+#include "data.hpp"
+
+#include <text_processing/count.hpp>
+
+#include <algorithm>
+
+namespace {
+
+template <Text::Case Sensitivity>
+void CountChar(benchmark::State& state)
+{
+    auto text = bench::records(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Text::count(text, '\n', Text::Start, Text::End, Text::Step, Sensitivity));
+    bench::processed(state, text.size());
+}
+BENCHMARK(CountChar<Text::Case::Sensitive>)->Apply(bench::text_sizes);
+BENCHMARK(CountChar<Text::Case::Insensitive>)->Apply(bench::text_sizes);
+
+void CountWord(benchmark::State& state)
+{
+    auto text = bench::words(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Text::count(text, "ab"));
+    bench::processed(state, text.size());
+}
+BENCHMARK(CountWord)->Apply(bench::text_sizes);
+
+void CountWithStep(benchmark::State& state)
+{
+    auto text = bench::records(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Text::count(text, ',', Text::Start, Text::End, state.range(1)));
+    bench::processed(state, text.size());
+}
+BENCHMARK(CountWithStep)->ArgsProduct({{1 << 16, 1 << 22}, {2, 3, -1, -2}});
+
+void CountAny(benchmark::State& state)
+{
+    auto text = bench::records(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Text::count_any(text, ",\n"));
+    bench::processed(state, text.size());
+}
+BENCHMARK(CountAny)->Apply(bench::text_sizes);
+
+void CountIf(benchmark::State& state)
+{
+    auto text = bench::records(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Text::count_if(text, [](char ch) { return ch == ',' || ch == '\n'; }));
+    bench::processed(state, text.size());
+}
+BENCHMARK(CountIf)->Apply(bench::text_sizes);
+
+void StdCount(benchmark::State& state)
+{
+    auto text = bench::records(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(std::count(text.begin(), text.end(), '\n'));
+    bench::processed(state, text.size());
+}
+BENCHMARK(StdCount)->Apply(bench::text_sizes);
+
+void StdCountIf(benchmark::State& state)
+{
+    auto text = bench::records(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(
+            std::count_if(text.begin(), text.end(), [](char ch) { return ch == ',' || ch == '\n'; }));
+    bench::processed(state, text.size());
+}
+BENCHMARK(StdCountIf)->Apply(bench::text_sizes);
+
+} // namespace
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <text_processing/common.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+// Text sizes used by most of benchmarks: 1 KiB, 64 KiB, 4 MiB
+inline void text_sizes(benchmark::internal::Benchmark* b)
+{
+    for (auto size : {1 << 10, 1 << 16, 1 << 22})
+        b->Arg(size);
+}
+
+// Pseudo random lowercase words separated by spaces, the same for every run
+inline std::string words(size_t size, unsigned seed = 1337)
+{
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> letter('a', 'z');
+    std::uniform_int_distribution<int> word_length(2, 10);
+    std::string text;
+    text.reserve(size);
+    while (text.size() < size)
+    {
+        auto length = word_length(gen);
+        for (int idx = 0; idx < length && text.size() < size; ++idx)
+            text += static_cast<char>(letter(gen));
+        if (text.size() < size)
+            text += ' ';
+    }
+    return text;
+}
+
+// Lines of comma separated words
+inline std::string records(size_t size, unsigned seed = 1337)
+{
+    auto text = words(size, seed);
+    for (size_t idx = 0; idx < text.size(); ++idx)
+        if (text[idx] == ' ')
+            text[idx] = idx % 7 == 0 ? '\n' : ',';
+    return text;
+}
+
+// Text with needle of given length appended at the end only, so searches scan whole text
+inline std::string needle_at_end(std::string& text, size_t needle_length)
+{
+    std::string needle(needle_length, 'x');
+    for (size_t idx = 0; idx < needle_length; idx += 3)
+        needle[idx] = 'y';
+    text += needle;
+    return needle;
+}
+
+inline void processed(benchmark::State& state, size_t bytes)
+{
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(bytes));
+}
+
+} // namespace bench
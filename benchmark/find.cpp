@@ -0,0 +1,196 @@
+#include "data.hpp"
+
+#include <text_processing/find.hpp>
+#include <text_processing/parallel.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+
+namespace {
+
+// Arguments: text size, needle size
+void needle_args(benchmark::internal::Benchmark* b)
+{
+    b->ArgsProduct({{1 << 10, 1 << 16, 1 << 22}, {1, 4, 16, 64}});
+}
+
+template <Text::Case Sensitivity>
+void Find(benchmark::State& state)
+{
+    auto text = bench::words(static_cast<size_t>(state.range(0)));
+    auto needle = bench::needle_at_end(text, static_cast<size_t>(state.range(1)));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Text::find(text, needle, Text::Start, Text::End, Text::Step, Sensitivity));
+    bench::processed(state, text.size());
+}
+BENCHMARK(Find<Text::Case::Sensitive>)->Apply(needle_args);
+BENCHMARK(Find<Text::Case::Insensitive>)->Apply(needle_args);
+
+// Rare marker at the end of a large text, thread pool of given size (0 runs without an executor)
+void ParallelFind(benchmark::State& state)
+{
+    auto text = bench::words(size_t{1} << 26);
+    auto needle = bench::needle_at_end(text, 8);
+    Text::ThreadPool pool(static_cast<size_t>(std::max<int64_t>(state.range(0), 1)));
+    for (auto _ : state)
+    {
+        if (state.range(0) == 0)
+            benchmark::DoNotOptimize(Text::find(text, needle));
+        else
+            benchmark::DoNotOptimize(Text::find(pool, text, needle));
+    }
+    bench::processed(state, text.size());
+}
+BENCHMARK(ParallelFind)->Arg(0)->Arg(1)->Arg(4)->UseRealTime();
+
+void ParallelCount(benchmark::State& state)
+{
+    auto text = bench::records(size_t{1} << 26);
+    Text::ThreadPool pool(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Text::count(pool, text, '\n'));
+    bench::processed(state, text.size());
+}
+BENCHMARK(ParallelCount)->Arg(1)->Arg(4)->UseRealTime();
+
+void FindSearcher(benchmark::State& state)
+{
+    auto text = bench::words(static_cast<size_t>(state.range(0)));
+    Text::Searcher needle(bench::needle_at_end(text, static_cast<size_t>(state.range(1))));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Text::find(text, needle));
+    bench::processed(state, text.size());
+}
+BENCHMARK(FindSearcher)->Apply(needle_args);
+
+void FindWithStep(benchmark::State& state)
+{
+    auto text = bench::words(static_cast<size_t>(state.range(0)));
+    auto needle = bench::needle_at_end(text, 4);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Text::find(text, needle, Text::Start, Text::End, state.range(1)));
+    bench::processed(state, text.size());
+}
+BENCHMARK(FindWithStep)->ArgsProduct({{1 << 16, 1 << 22}, {2, 3, 8}});
+
+void RFind(benchmark::State& state)
+{
+    auto needle = std::string(static_cast<size_t>(state.range(1)), 'y');
+    auto text = needle + bench::words(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Text::rfind(text, needle));
+    bench::processed(state, text.size());
+}
+BENCHMARK(RFind)->Apply(needle_args);
+
+void StdStringFind(benchmark::State& state)
+{
+    auto text = bench::words(static_cast<size_t>(state.range(0)));
+    auto needle = bench::needle_at_end(text, static_cast<size_t>(state.range(1)));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(text.find(needle));
+    bench::processed(state, text.size());
+}
+BENCHMARK(StdStringFind)->Apply(needle_args);
+
+void StdStringRFind(benchmark::State& state)
+{
+    auto needle = std::string(static_cast<size_t>(state.range(1)), 'y');
+    auto text = needle + bench::words(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(text.rfind(needle));
+    bench::processed(state, text.size());
+}
+BENCHMARK(StdStringRFind)->Apply(needle_args);
+
+void StdBoyerMooreSearch(benchmark::State& state)
+{
+    auto text = bench::words(static_cast<size_t>(state.range(0)));
+    auto needle = bench::needle_at_end(text, static_cast<size_t>(state.range(1)));
+    std::boyer_moore_searcher searcher(needle.begin(), needle.end());
+    for (auto _ : state)
+        benchmark::DoNotOptimize(std::search(text.begin(), text.end(), searcher));
+    bench::processed(state, text.size());
+}
+BENCHMARK(StdBoyerMooreSearch)->Apply(needle_args);
+
+void FindChar(benchmark::State& state)
+{
+    auto text = bench::words(static_cast<size_t>(state.range(0))) + '#';
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Text::find(text, '#'));
+    bench::processed(state, text.size());
+}
+BENCHMARK(FindChar)->Apply(bench::text_sizes);
+
+void Memchr(benchmark::State& state)
+{
+    auto text = bench::words(static_cast<size_t>(state.range(0))) + '#';
+    for (auto _ : state)
+        benchmark::DoNotOptimize(std::memchr(text.data(), '#', text.size()));
+    bench::processed(state, text.size());
+}
+BENCHMARK(Memchr)->Apply(bench::text_sizes);
+
+// Arguments: text size, number of delimiters
+void FindAny(benchmark::State& state)
+{
+    auto text = bench::words(static_cast<size_t>(state.range(0))) + '#';
+    std::string delimiters = "#0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    delimiters.resize(static_cast<size_t>(state.range(1)));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Text::find_any(text, delimiters));
+    bench::processed(state, text.size());
+}
+BENCHMARK(FindAny)->ArgsProduct({{1 << 10, 1 << 16, 1 << 22}, {1, 4, 16}});
+
+void FindAnyInsensitive(benchmark::State& state)
+{
+    auto text = bench::words(static_cast<size_t>(state.range(0))) + '#';
+    for (auto _ : state)
+        benchmark::DoNotOptimize(
+            Text::find_any(text, "#XYZ", Text::Start, Text::End, Text::Step, Text::Case::Insensitive));
+    bench::processed(state, text.size());
+}
+BENCHMARK(FindAnyInsensitive)->Apply(bench::text_sizes);
+
+void RFindAny(benchmark::State& state)
+{
+    auto text = '#' + bench::words(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Text::rfind_any(text, "#0123"));
+    bench::processed(state, text.size());
+}
+BENCHMARK(RFindAny)->Apply(bench::text_sizes);
+
+void StdStringFindFirstOf(benchmark::State& state)
+{
+    auto text = bench::words(static_cast<size_t>(state.range(0))) + '#';
+    std::string delimiters = "#0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    delimiters.resize(static_cast<size_t>(state.range(1)));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(text.find_first_of(delimiters));
+    bench::processed(state, text.size());
+}
+BENCHMARK(StdStringFindFirstOf)->ArgsProduct({{1 << 10, 1 << 16, 1 << 22}, {1, 4, 16}});
+
+void FindIf(benchmark::State& state)
+{
+    auto text = bench::words(static_cast<size_t>(state.range(0))) + '#';
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Text::find_if(text, [](char ch) { return ch == '#'; }));
+    bench::processed(state, text.size());
+}
+BENCHMARK(FindIf)->Apply(bench::text_sizes);
+
+void StdFindIf(benchmark::State& state)
+{
+    auto text = bench::words(static_cast<size_t>(state.range(0))) + '#';
+    for (auto _ : state)
+        benchmark::DoNotOptimize(std::find_if(text.begin(), text.end(), [](char ch) { return ch == '#'; }));
+    bench::processed(state, text.size());
+}
+BENCHMARK(StdFindIf)->Apply(bench::text_sizes);
+
+} // namespace
@@ -0,0 +1,71 @@
+#include "data.hpp"
+
+#include <text_processing/join.hpp>
+#include <text_processing/join_writer.hpp>
+#include <text_processing/split.hpp>
+
+namespace {
+
+void Join(benchmark::State& state)
+{
+    auto text = bench::words(static_cast<size_t>(state.range(0)));
+    auto words = Text::split(text, ' ');
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Text::join(words, ", "));
+    bench::processed(state, text.size());
+}
+BENCHMARK(Join)->Apply(bench::text_sizes);
+
+// Lines assembled in one reused buffer
+void JoinInto(benchmark::State& state)
+{
+    auto text = bench::words(static_cast<size_t>(state.range(0)));
+    auto words = Text::split(text, ' ');
+    std::string line;
+    for (auto _ : state)
+    {
+        line.clear();
+        benchmark::DoNotOptimize(Text::join_into(line, words, ", "));
+    }
+    bench::processed(state, text.size());
+}
+BENCHMARK(JoinInto)->Apply(bench::text_sizes);
+
+// Joined text streamed through the writer buffer to a sink that only counts bytes
+void JoinWriter(benchmark::State& state)
+{
+    auto text = bench::words(static_cast<size_t>(state.range(0)));
+    auto words = Text::split(text, ' ');
+    for (auto _ : state)
+    {
+        size_t written = 0;
+        {
+            auto writer = Text::join_writer([&](std::string_view data) { written += data.size(); }, ", ");
+            writer.add_range(words);
+        }
+        benchmark::DoNotOptimize(written);
+    }
+    bench::processed(state, text.size());
+}
+BENCHMARK(JoinWriter)->Apply(bench::text_sizes);
+
+void StdStringAppend(benchmark::State& state)
+{
+    auto text = bench::words(static_cast<size_t>(state.range(0)));
+    auto words = Text::split(text, ' ');
+    for (auto _ : state)
+    {
+        std::string result;
+        for (size_t idx = 0; idx < words.size(); ++idx)
+        {
+            if (idx != 0)
+                result += ", ";
+            result += words[idx];
+        }
+        benchmark::DoNotOptimize(result);
+    }
+    bench::processed(state, text.size());
+}
+BENCHMARK(StdStringAppend)->Apply(bench::text_sizes);
+
+} // namespace
@@ -0,0 +1,147 @@
+#include "data.hpp"
+
+#include <text_processing/remove.hpp>
+#include <text_processing/replace.hpp>
+
+namespace {
+
+// Arguments: text size, replacement size (needle has two characters)
+void Replace(benchmark::State& state)
+{
+    auto original = bench::words(static_cast<size_t>(state.range(0)));
+    std::string replacement(static_cast<size_t>(state.range(1)), '_');
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto text = original;
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(Text::replace(text, "a ", replacement, Text::Start, Text::End, Text::Step,
+                                               Text::Case::Sensitive));
+    }
+    bench::processed(state, original.size());
+}
+BENCHMARK(Replace)->ArgsProduct({{1 << 10, 1 << 16, 1 << 22}, {1, 2, 4}});
+
+void Replaced(benchmark::State& state)
+{
+    auto text = bench::words(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Text::replaced(text, "a ", "__"));
+    bench::processed(state, text.size());
+}
+BENCHMARK(Replaced)->Apply(bench::text_sizes);
+
+void ReplaceAny(benchmark::State& state)
+{
+    auto original = bench::records(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto text = original;
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(Text::replace_any(text, ",\n", "\t"));
+    }
+    bench::processed(state, original.size());
+}
+BENCHMARK(ReplaceAny)->Apply(bench::text_sizes);
+
+void ReplaceIf(benchmark::State& state)
+{
+    auto original = bench::records(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto text = original;
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(Text::replace_if(text, [](char ch) { return ch == ',' || ch == '\n'; }, "\t"));
+    }
+    bench::processed(state, original.size());
+}
+BENCHMARK(ReplaceIf)->Apply(bench::text_sizes);
+
+// Hand written loop over std::string::find and std::string::replace
+void StdStringReplace(benchmark::State& state)
+{
+    auto original = bench::words(static_cast<size_t>(state.range(0)));
+    std::string replacement(static_cast<size_t>(state.range(1)), '_');
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto text = original;
+        state.ResumeTiming();
+        for (auto pos = text.find("a "); pos != std::string::npos; pos = text.find("a ", pos + replacement.size()))
+            text.replace(pos, 2, replacement);
+        benchmark::DoNotOptimize(text);
+    }
+    bench::processed(state, original.size());
+}
+BENCHMARK(StdStringReplace)->ArgsProduct({{1 << 10, 1 << 16, 1 << 22}, {1, 2, 4}});
+
+void Remove(benchmark::State& state)
+{
+    auto original = bench::words(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto text = original;
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(Text::remove(text, "a "));
+    }
+    bench::processed(state, original.size());
+}
+BENCHMARK(Remove)->Apply(bench::text_sizes);
+
+void RemoveAny(benchmark::State& state)
+{
+    auto original = bench::records(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto text = original;
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(Text::remove_any(text, ",\n"));
+    }
+    bench::processed(state, original.size());
+}
+BENCHMARK(RemoveAny)->Apply(bench::text_sizes);
+
+void RemoveIf(benchmark::State& state)
+{
+    auto original = bench::records(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto text = original;
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(Text::remove_if(text, [](char ch) { return ch == ',' || ch == '\n'; }));
+    }
+    bench::processed(state, original.size());
+}
+BENCHMARK(RemoveIf)->Apply(bench::text_sizes);
+
+void RemovedAnyInto(benchmark::State& state)
+{
+    auto text = bench::records(static_cast<size_t>(state.range(0)));
+    std::string buffer(text.size(), '\0');
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Text::removed_any_into(text, ",\n", buffer.data()));
+    bench::processed(state, text.size());
+}
+BENCHMARK(RemovedAnyInto)->Apply(bench::text_sizes);
+
+void StdRemoveErase(benchmark::State& state)
+{
+    auto original = bench::records(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto text = original;
+        state.ResumeTiming();
+        std::erase_if(text, [](char ch) { return ch == ',' || ch == '\n'; });
+        benchmark::DoNotOptimize(text);
+    }
+    bench::processed(state, original.size());
+}
+BENCHMARK(StdRemoveErase)->Apply(bench::text_sizes);
+
+} // namespace
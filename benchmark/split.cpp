@@ -0,0 +1,103 @@
+#include "data.hpp"
+
+#include <text_processing/parallel_split.hpp>
+#include <text_processing/split.hpp>
+
+namespace {
+
+template <Text::SplitBehavior Behavior>
+void Split(benchmark::State& state)
+{
+    auto text = bench::words(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Text::split(text, ' ', Behavior));
+    bench::processed(state, text.size());
+}
+BENCHMARK(Split<Text::SplitBehavior::KeepEmpty>)->Apply(bench::text_sizes);
+BENCHMARK(Split<Text::SplitBehavior::DropEmpty>)->Apply(bench::text_sizes);
+
+void ParallelSplit(benchmark::State& state)
+{
+    auto text = bench::words(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Text::parallel_split(text, "A ", Text::SplitBehavior::KeepEmpty, Text::Start,
+                                                      Text::End, Text::Step, Text::Case::Sensitive,
+                                                      static_cast<size_t>(state.range(1))));
+    bench::processed(state, text.size());
+}
+BENCHMARK(ParallelSplit)->ArgsProduct({{1 << 22, 1 << 26}, {1, 4, 0}})->UseRealTime();
+
+void SplitWord(benchmark::State& state)
+{
+    auto text = bench::words(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(
+            Text::split(text, "A ", Text::SplitBehavior::KeepEmpty, Text::Start, Text::End, Text::Step,
+                        state.range(1) != 0 ? Text::Case::Insensitive : Text::Case::Sensitive));
+    bench::processed(state, text.size());
+}
+BENCHMARK(SplitWord)->ArgsProduct({{1 << 10, 1 << 16, 1 << 22}, {0, 1}});
+
+void SplitWithStep(benchmark::State& state)
+{
+    auto text = bench::words(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Text::split(text, ' ', Text::SplitBehavior::KeepEmpty, Text::Start, Text::End,
+                                             state.range(1)));
+    bench::processed(state, text.size());
+}
+BENCHMARK(SplitWithStep)->ArgsProduct({{1 << 16, 1 << 22}, {2, 3}});
+
+void SplitView(benchmark::State& state)
+{
+    auto text = bench::words(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        size_t total = 0;
+        for (auto word : Text::split_view(text, ' '))
+            total += word.size();
+        benchmark::DoNotOptimize(total);
+    }
+    bench::processed(state, text.size());
+}
+BENCHMARK(SplitView)->Apply(bench::text_sizes);
+
+void SplitAny(benchmark::State& state)
+{
+    auto text = bench::records(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Text::split_any(text, ",\n"));
+    bench::processed(state, text.size());
+}
+BENCHMARK(SplitAny)->Apply(bench::text_sizes);
+
+void SplitIf(benchmark::State& state)
+{
+    auto text = bench::records(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Text::split_if(text, [](char ch) { return ch == ',' || ch == '\n'; }));
+    bench::processed(state, text.size());
+}
+BENCHMARK(SplitIf)->Apply(bench::text_sizes);
+
+// Hand written loop over std::string_view::find, a typical replacement for split
+void StdStringViewSplit(benchmark::State& state)
+{
+    auto text = bench::words(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        std::vector<std::string_view> result;
+        std::string_view rest(text);
+        for (auto pos = rest.find(' '); pos != std::string_view::npos; pos = rest.find(' '))
+        {
+            result.push_back(rest.substr(0, pos));
+            rest.remove_prefix(pos + 1);
+        }
+        result.push_back(rest);
+        benchmark::DoNotOptimize(result);
+    }
+    bench::processed(state, text.size());
+}
+BENCHMARK(StdStringViewSplit)->Apply(bench::text_sizes);
+
+} // namespace
@@ -0,0 +1,49 @@
+#include "data.hpp"
+
+#include <text_processing/sub.hpp>
+
+namespace {
+
+void LeftView(benchmark::State& state)
+{
+    auto text = bench::words(1 << 10);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Text::left_view(text, 100));
+}
+BENCHMARK(LeftView);
+
+void RightView(benchmark::State& state)
+{
+    auto text = bench::words(1 << 10);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Text::right_view(text, 100));
+}
+BENCHMARK(RightView);
+
+void MidView(benchmark::State& state)
+{
+    auto text = bench::words(1 << 10);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Text::mid_view(text, -200, 100));
+}
+BENCHMARK(MidView);
+
+void Mid(benchmark::State& state)
+{
+    auto text = bench::words(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Text::mid(text, 10, -10));
+    bench::processed(state, text.size());
+}
+BENCHMARK(Mid)->Apply(bench::text_sizes);
+
+void StdStringViewSubstr(benchmark::State& state)
+{
+    auto text = bench::words(1 << 10);
+    std::string_view view(text);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(view.substr(view.size() - 200, 100));
+}
+BENCHMARK(StdStringViewSubstr);
+
+} // namespace
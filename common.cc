@@ -157,3 +157,69 @@ TEST(Common, DelimiterFromElement)
     ASSERT_EQ(txt.length, 1);
     ASSERT_EQ(*txt.ptr, ch);
 }
+
+TEST(Common, DelimitersBitmap)
+{
+    using namespace std::literals;
+    Text::Delimiters delimiters(" \t\xff"sv, Text::Case::Sensitive);
+    EXPECT_TRUE(delimiters.contains(' '));
+    EXPECT_TRUE(delimiters.contains('\t'));
+    EXPECT_TRUE(delimiters.contains('\xff'));
+    EXPECT_FALSE(delimiters.contains('\n'));
+    EXPECT_FALSE(delimiters.contains('\0'));
+}
+
+TEST(Common, DelimitersCaseInsensitive)
+{
+    using namespace std::literals;
+    Text::Delimiters delimiters("aB,"sv, Text::Case::Insensitive);
+    for (auto ch : "aAbB,"sv)
+        EXPECT_TRUE(delimiters.contains(ch));
+    EXPECT_FALSE(delimiters.contains('c'));
+    EXPECT_FALSE(delimiters.contains('<'));
+}
+
+TEST(Common, DelimitersWide)
+{
+    using namespace std::literals;
+    Text::Delimiters delimiters(L"zZ\u0104 z"sv, Text::Case::Sensitive);
+    EXPECT_EQ(delimiters.delimiters.size(), 4);
+    EXPECT_TRUE(delimiters.contains(L'\u0104'));
+    EXPECT_TRUE(delimiters.contains(L' '));
+    EXPECT_FALSE(delimiters.contains(L'\u0105'));
+    Text::Delimiters insensitive(L"z"sv, Text::Case::Insensitive);
+    EXPECT_TRUE(insensitive.contains(L'Z'));
+}
+
+TEST(Common, DelimitersCustomType)
+{
+    struct MyType
+    {
+        int val;
+        bool operator<(const MyType& other) const
+        {
+            return val < other.val;
+        }
+    };
+
+    std::vector<MyType> data{{3}, {1}, {3}, {2}};
+    Text::Delimiters delimiters(data, Text::Case::Sensitive);
+    EXPECT_EQ(delimiters.delimiters.size(), 3);
+    EXPECT_TRUE(delimiters.contains(MyType{2}));
+    EXPECT_FALSE(delimiters.contains(MyType{4}));
+}
+
+TEST(Common, SanitizeIndexLargeText)
+{
+    constexpr size_t size = 5'000'000'000;
+    Text::Index index = -1;
+    EXPECT_EQ(4'999'999'999, Text::sanitize_index(index, size));
+    EXPECT_EQ(4'999'999'999, index);
+    EXPECT_EQ(static_cast<Text::Index>(size), Text::sanitize_index(Text::End, size));
+    EXPECT_EQ(3'000'000'000, Text::sanitize_index(Text::Index{3'000'000'000}, size));
+}
+
+TEST(Common, SanitizeIntMaxIndexAsEnd)
+{
+    EXPECT_EQ(24, Text::sanitize_index(std::numeric_limits<int>::max(), 24));
+}
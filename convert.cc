@@ -1,9 +1,14 @@
 #include <text_processing/convert.hpp>
+#include <text_processing/join.hpp>
 
 #include <gtest/gtest.h>
 #include <gtest/gtest-matchers.h>
 #include <gmock/gmock-more-matchers.h>
 
+#include <array>
+#include <list>
+#include <random>
+
 using namespace ::testing;
 
 TEST(Convert, StringToInt)
@@ -188,3 +193,193 @@ TEST(Convert, VectorOfStringsToVectorOfDoublesOutOfRange)
     );
 }
 
+
+TEST(SplitConvert, IntsIntoSpan)
+{
+    using namespace std::literals;
+    std::array<int32_t, 4> values{};
+    auto result = Text::split_convert<int32_t>("1,-2,30,4"sv, ',', std::span(values));
+    EXPECT_TRUE(result.ok());
+    EXPECT_THAT(result.count, Eq(4u));
+    EXPECT_THAT(values, ElementsAre(1, -2, 30, 4));
+}
+
+TEST(SplitConvert, ReportsInvalidFields)
+{
+    using namespace std::literals;
+    std::vector<int32_t> values{7, 7, 7, 7, 7, 7};
+    auto result = Text::split_convert<int32_t>("1,x,2147483648,,5"sv, ',', values);
+    EXPECT_FALSE(result.ok());
+    EXPECT_THAT(values, ElementsAre(1, 0, 0, 0, 5));
+    EXPECT_THAT(result.errors, ElementsAre(Text::FieldError{1, 2, std::errc::invalid_argument},
+                                           Text::FieldError{2, 4, std::errc::result_out_of_range},
+                                           Text::FieldError{3, 15, std::errc::invalid_argument}));
+}
+
+TEST(SplitConvert, TruncatedWhenSpanIsFull)
+{
+    using namespace std::literals;
+    std::array<int64_t, 2> values{};
+    auto result = Text::split_convert<int64_t>("10 20 x"sv, " "sv, std::span(values));
+    EXPECT_TRUE(result.truncated);
+    EXPECT_TRUE(result.errors.empty());
+    EXPECT_THAT(result.count, Eq(2u));
+    EXPECT_THAT(values, ElementsAre(10, 20));
+}
+
+TEST(SplitConvertAny, DropEmpty)
+{
+    using namespace std::literals;
+    std::vector<int32_t> values;
+    auto result = Text::split_convert_any<int32_t>("1, 2;\n3\n"sv, ",; \n"sv, values, Text::SplitBehavior::DropEmpty);
+    EXPECT_TRUE(result.ok());
+    EXPECT_THAT(values, ElementsAre(1, 2, 3));
+}
+
+TEST(TryConvert, SingleValue)
+{
+    using namespace std::literals;
+    auto good = Text::try_convert<int32_t>("12"sv);
+    EXPECT_TRUE(good);
+    EXPECT_THAT(good.value, Eq(12));
+    EXPECT_THAT(good.offset, Eq(2));
+
+    auto bad = Text::try_convert<int32_t>("x1"sv);
+    EXPECT_FALSE(bad);
+    EXPECT_THAT(bad.error, Eq(std::errc::invalid_argument));
+    EXPECT_THAT(bad.offset, Eq(0));
+
+    auto overflow = Text::try_convert<int32_t>("2147483648"s);
+    EXPECT_THAT(overflow.error, Eq(std::errc::result_out_of_range));
+    EXPECT_THAT(overflow.value, Eq(0));
+}
+
+TEST(TryConvert, BatchReportsFailedIndices)
+{
+    using namespace std::literals;
+    std::vector<std::string_view> input{"1"sv, "a"sv, "3"sv, "99999999999"sv};
+    auto result = Text::try_convert<int32_t>(input);
+    EXPECT_FALSE(result.ok());
+    EXPECT_THAT(result.values, ElementsAre(1, 0, 3, 0));
+    EXPECT_THAT(result.errors, ElementsAre(Text::FieldError{1, 0, std::errc::invalid_argument},
+                                           Text::FieldError{3, 11, std::errc::result_out_of_range}));
+}
+
+template <typename R>
+void expect_same_as_from_chars(std::string_view input)
+{
+    R expected{};
+    auto [expected_ptr, expected_ec] = std::from_chars(input.data(), input.data() + input.size(), expected);
+    auto result = Text::try_convert<R>(input);
+    EXPECT_EQ(result.error, expected_ec) << input;
+    EXPECT_EQ(result.offset, expected_ptr - input.data()) << input;
+    if (expected_ec == std::errc())
+    {
+        EXPECT_EQ(result.value, expected) << input;
+    }
+}
+
+TEST(TryConvert, IntegersMatchFromChars)
+{
+    std::vector<std::string> inputs{"",
+                                    "-",
+                                    "+1",
+                                    "0",
+                                    "-0",
+                                    "7",
+                                    "00000000000000000000000000042",
+                                    "12345678",
+                                    "123456789",
+                                    "1234567890123456",
+                                    "127",
+                                    "128",
+                                    "-128",
+                                    "-129",
+                                    "255",
+                                    "256",
+                                    "32767",
+                                    "-32768",
+                                    "65535",
+                                    "2147483647",
+                                    "2147483648",
+                                    "-2147483648",
+                                    "-2147483649",
+                                    "4294967295",
+                                    "4294967296",
+                                    "9223372036854775807",
+                                    "9223372036854775808",
+                                    "-9223372036854775808",
+                                    "-9223372036854775809",
+                                    "18446744073709551615",
+                                    "18446744073709551616",
+                                    "99999999999999999999999",
+                                    "12ab",
+                                    "1234567:",
+                                    "12345678/9",
+                                    " 1",
+                                    "1 2",
+                                    "--1"};
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> length(1, 24);
+    std::uniform_int_distribution<int> chars(0, 12);
+    for (int idx = 0; idx < 2000; ++idx)
+    {
+        std::string input;
+        for (int pos = length(gen); pos > 0; --pos)
+        {
+            auto ch = chars(gen);
+            input += ch < 10 ? static_cast<char>('0' + ch) : ch == 10 ? '-' : ch == 11 ? '/' : ':';
+        }
+        inputs.push_back(input);
+    }
+    for (const auto& input : inputs)
+    {
+        expect_same_as_from_chars<int8_t>(input);
+        expect_same_as_from_chars<uint8_t>(input);
+        expect_same_as_from_chars<int16_t>(input);
+        expect_same_as_from_chars<uint16_t>(input);
+        expect_same_as_from_chars<int32_t>(input);
+        expect_same_as_from_chars<uint32_t>(input);
+        expect_same_as_from_chars<int64_t>(input);
+        expect_same_as_from_chars<uint64_t>(input);
+    }
+}
+
+TEST(FormatInto, AppendsShortestRepresentation)
+{
+    std::string out("x=");
+    Text::format_into(out, -42);
+    EXPECT_EQ(out, "x=-42");
+    Text::format_into(out.append(",y="), 0.1);
+    EXPECT_EQ(out, "x=-42,y=0.1");
+    out.clear();
+    Text::format_into(out, std::numeric_limits<int64_t>::min());
+    EXPECT_EQ(out, "-9223372036854775808");
+    EXPECT_EQ(out.size(), Text::max_chars<int64_t>());
+    out.clear();
+    Text::format_into(out, std::numeric_limits<uint64_t>::max());
+    EXPECT_EQ(out.size(), Text::max_chars<uint64_t>());
+    out.clear();
+    Text::format_into(out, -std::numeric_limits<double>::denorm_min() * 3);
+    Text::format_into(out, -1.2345678901234567e-300);
+    Text::format_into(out, -std::numeric_limits<float>::max());
+    EXPECT_LE(out.size(), 2 * Text::max_chars<double>() + Text::max_chars<float>());
+    EXPECT_EQ(out.substr(0, 9), "-1.5e-323");
+}
+
+TEST(JoinNumbers, SameAsJoinOfStrings)
+{
+    using namespace std::literals;
+    std::vector<int> values{1, -20, 300, 0, std::numeric_limits<int>::min()};
+    std::vector<std::string> strings;
+    for (auto value : values)
+        strings.push_back(std::to_string(value));
+    EXPECT_EQ(Text::join_numbers(values, ", "sv), Text::join(strings, ", "sv));
+    EXPECT_EQ(Text::join_numbers(std::vector<double>{0.5, 1e100, -2.25}, ','), "0.5,1e+100,-2.25");
+    EXPECT_EQ(Text::join_numbers(std::array<uint8_t, 3>{1, 2, 255}, ""), "12255");
+    EXPECT_EQ(Text::join_numbers(std::vector<long>{}, ','), "");
+
+    std::string row("row,");
+    Text::format_into(row, std::list<short>{7, -8}, ';');
+    EXPECT_EQ(row, "row,7;-8");
+}
@@ -138,3 +138,71 @@ TEST(CountAny, WithSteps)
     auto result = Text::count_any(simple_sv, "sw", Text::Start, Text::End, 2);
     EXPECT_EQ(result, 2);
 }
+
+TEST(Count, Overlapping)
+{
+    using namespace std::literals;
+    EXPECT_EQ(Text::count("aaaa"sv, "aa"), 3);
+    EXPECT_EQ(Text::count("aaaa"sv, "aa", Text::Start, Text::End, -1), 3);
+}
+
+TEST(Count, NegativeStep)
+{
+    using namespace std::literals;
+    auto simple_sv = "simple string with words"sv;
+    // Lattice is anchored at the last position: 23, 21, 19, ...
+    EXPECT_EQ(Text::count(simple_sv, "s", Text::Start, Text::End, -2), 2);
+    EXPECT_EQ(Text::count(simple_sv, "s", Text::Start, Text::End, -1), 3);
+    EXPECT_EQ(Text::count_any(simple_sv, "sw", Text::Start, Text::End, -2), 3);
+    EXPECT_EQ(Text::count_if(simple_sv, [](auto ch) { return ch > 'u'; }, Text::Start, Text::End, -1), 2);
+}
+
+TEST(Count, LongTextMatchesNaive)
+{
+    std::string text;
+    for (int idx = 0; idx < 1000; ++idx)
+        text += static_cast<char>("abcXY\n,"[idx * 7 % 11 % 7]);
+    for (Text::Index start : {0, 3, 17, 500})
+    {
+        for (Text::Index end : {Text::End, Text::Index{999}, Text::Index{640}, Text::Index{100}})
+        {
+            if (end < start)
+                continue;
+            auto lines = std::count(text.begin() + start, end == Text::End ? text.end() : text.begin() + end, '\n');
+            auto any = std::count_if(text.begin() + start, end == Text::End ? text.end() : text.begin() + end,
+                                     [](char ch) { return ch == '\n' || ch == ',' || ch == 'x' || ch == 'X'; });
+            EXPECT_EQ(Text::count(text, '\n', start, end), lines);
+            EXPECT_EQ(Text::count_any(text, "\n,x", start, end, Text::Step, Text::Case::Insensitive), any);
+            EXPECT_EQ(Text::count_if(text, [](char ch) { return ch == '\n'; }, start, end), lines);
+        }
+    }
+}
+
+TEST(Count, CaseInsensitiveChar)
+{
+    using namespace std::literals;
+    std::string text(100, 'a');
+    text += std::string(50, 'A');
+    EXPECT_EQ(Text::count(text, 'A', Text::Start, Text::End, Text::Step, Text::Case::Insensitive), 150);
+    EXPECT_EQ(Text::count(text, 'A'), 50);
+}
+
+TEST(Count, StridedViewMatchesCopy)
+{
+    std::string text;
+    for (size_t idx = 0; idx < 97; ++idx)
+        text += "abc"[(idx * idx + idx / 3) % 3];
+    for (Text::Index stride : {-3, -2, -1, 1, 2, 3})
+    {
+        auto view = Text::slice_view(text, 2, Text::End, stride);
+        auto copy = Text::slice(text, 2, Text::End, stride);
+        for (auto needle : {"a", "ab", "bca"})
+            for (Text::Index step : {-3, -1, 1, 2})
+                for (Text::Index start : {0, 5, -8})
+                    EXPECT_EQ(Text::count(view, needle, start, Text::End, step),
+                              Text::count(copy, needle, start, Text::End, step));
+    }
+    EXPECT_EQ(Text::count(Text::slice_view("aXbXaXBX", Text::Start, Text::End, 2), "aB", Text::Start, Text::End,
+                          Text::Step, Text::Case::Insensitive),
+              2);
+}
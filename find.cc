@@ -123,9 +123,9 @@ TEST(Find, MultipleWithView)
 {
     using namespace std::literals;
     std::string simple("simple string with words");
-    auto start = 0;
-    auto result = 0;
-    std::vector<int> expected{6, 13, 18};
+    Text::Index start = 0;
+    Text::Index result = 0;
+    std::vector<Text::Index> expected{6, 13, 18};
     auto needle = " "sv;
     for (const auto exp : expected)
     {
@@ -193,6 +193,101 @@ TEST(Find, WithSteps)
     EXPECT_EQ(result, 7);
 }
 
+TEST(Find, LongTextMatchAcrossBlocks)
+{
+    using namespace std::literals;
+    std::string simple(200, 'a');
+    simple.replace(150, 5, "needl");
+    simple.replace(170, 6, "needle");
+    auto result = Text::find(simple, "needle"sv);
+    EXPECT_EQ(result, 170);
+}
+
+TEST(Find, LongTextMatchAtTheEnd)
+{
+    using namespace std::literals;
+    std::string simple(100, 'x');
+    simple += "end";
+    EXPECT_EQ(Text::find(simple, "end"sv), 100);
+    EXPECT_EQ(Text::find(simple, "end"sv, Text::Start, -1), Text::End);
+    EXPECT_EQ(Text::find(simple, 'd'), 102);
+}
+
+TEST(Find, LongTextCaseInsensitive)
+{
+    using namespace std::literals;
+    std::string simple(64, '@');
+    simple += "NeEdLe";
+    auto result = Text::find(simple, "nEeDlE"sv, Text::Start, Text::End, Text::Step, Text::Case::Insensitive);
+    EXPECT_EQ(result, 64);
+    result = Text::find(simple, "`eedle"sv, Text::Start, Text::End, Text::Step, Text::Case::Insensitive);
+    EXPECT_EQ(result, Text::End);
+}
+
+TEST(Find, LongTextSameAsStdFind)
+{
+    std::string simple;
+    for (int idx = 0; idx < 1000; ++idx)
+        simple += static_cast<char>('a' + (idx * 7 + idx / 13) % 5);
+    for (const auto* needle : {"a", "ab", "cde", "abcda", "eeeee", "dcbaedcba"})
+        for (int start = 0; start < 70; start += 7)
+        {
+            auto expected = simple.find(needle, static_cast<size_t>(start));
+            auto result = Text::find(simple, std::string_view(needle), start);
+            EXPECT_EQ(result, expected == std::string::npos ? Text::End : static_cast<int>(expected));
+        }
+}
+
+TEST(Find, LongNeedleSameAsStdFind)
+{
+    std::string simple;
+    for (int idx = 0; idx < 3000; ++idx)
+        simple += static_cast<char>('a' + (idx % 17 == 0) + (idx % 289 == 0));
+    std::vector<std::string> needles{std::string(40, 'a'), std::string(16, 'a') + "b" + std::string(16, 'a'),
+                                     simple.substr(1000, 300), simple.substr(1155, 35) + "c",
+                                     "b" + std::string(16, 'a') + "c" + std::string(16, 'a') + "b"};
+    for (const auto& needle : needles)
+        for (int start = 0; start < 2000; start += 333)
+        {
+            auto expected = simple.find(needle, static_cast<size_t>(start));
+            auto result = Text::find(simple, needle, start);
+            EXPECT_EQ(result, expected == std::string::npos ? Text::End : static_cast<int>(expected));
+            expected = simple.rfind(needle, simple.size() - static_cast<size_t>(start) - needle.size());
+            result = Text::rfind(simple, needle, Text::Start, start == 0 ? Text::End : -start);
+            EXPECT_EQ(result, expected == std::string::npos ? Text::End : static_cast<int>(expected));
+        }
+}
+
+TEST(Find, LongNeedleCaseInsensitive)
+{
+    using namespace std::literals;
+    std::string simple(100, 'x');
+    simple += "The Quick Brown Fox Jumps Over The Lazy Dog";
+    simple += std::string(100, 'x');
+    auto needle = "the quick brown fox jumps over the lazy dog"sv;
+    EXPECT_EQ(Text::find(simple, needle, Text::Start, Text::End, Text::Step, Text::Case::Insensitive), 100);
+    EXPECT_EQ(Text::rfind(simple, needle, Text::Start, Text::End, Text::Step, Text::Case::Insensitive), 100);
+    EXPECT_EQ(Text::find(simple, needle), Text::End);
+}
+
+TEST(Find, LongNeedleWideText)
+{
+    std::wstring simple(200, L'a');
+    simple += L"abababababababababababababababababababababab";
+    std::wstring needle(L"abababababab");
+    EXPECT_EQ(Text::find(simple, needle), 200);
+    EXPECT_EQ(Text::rfind(simple, needle), 200 + 44 - 12);
+}
+
+TEST(Find, LongUint8Text)
+{
+    std::basic_string<uint8_t> simple(300, 0xff);
+    simple[280] = 0x80;
+    simple[281] = 0x00;
+    auto result = Text::find(simple, std::basic_string<uint8_t>{0x80, 0x00});
+    EXPECT_EQ(result, 280);
+}
+
 TEST(FindIf, View)
 {
     using namespace std::literals;
@@ -389,9 +484,9 @@ TEST(FindAny, MultipleWithView)
 {
     using namespace std::literals;
     std::string_view simple("simple string with words");
-    auto start = 0;
-    auto result = 0;
-    std::vector<int> expected{8, 12, 16};
+    Text::Index start = 0;
+    Text::Index result = 0;
+    std::vector<Text::Index> expected{8, 12, 16};
     auto needle = "tg"sv;
     for (const auto exp : expected)
     {
@@ -427,6 +522,40 @@ TEST(FindAny, WithSteps)
     EXPECT_EQ(result, 7);
 }
 
+TEST(FindAny, RespectsEnd)
+{
+    using namespace std::literals;
+    std::string_view simple("simple string with words");
+    EXPECT_EQ(Text::find_any(simple, "w"sv, Text::Start, 14), Text::End);
+    EXPECT_EQ(Text::find_any(simple, "w"sv, Text::Start, 15), 14);
+}
+
+TEST(FindAny, LongTextManyDelimiters)
+{
+    std::string simple(300, 'x');
+    simple[77] = '\xe4';
+    simple[200] = '~';
+    simple[250] = '\t';
+    // Delimiters spread over more than 8 distinct high nibbles
+    std::string delimiters{'\t', ' ', '0', '@', 'P', '`', 'p', '\x80', '\x90', '\xa0', '\xe4', '~'};
+    EXPECT_EQ(Text::find_any(simple, delimiters), 77);
+    EXPECT_EQ(Text::find_any(simple, delimiters, 78), 200);
+    EXPECT_EQ(Text::rfind_any(simple, delimiters), 250);
+    EXPECT_EQ(Text::rfind_any(simple, delimiters, Text::Start, 250), 200);
+    EXPECT_EQ(Text::find_any(simple, "ab"), Text::End);
+    EXPECT_EQ(Text::rfind_any(simple, "ab"), Text::End);
+}
+
+TEST(FindAny, LongTextCaseInsensitive)
+{
+    using namespace std::literals;
+    std::string simple(100, '.');
+    simple[60] = 'Q';
+    EXPECT_EQ(Text::find_any(simple, "qz"sv, Text::Start, Text::End, Text::Step, Text::Case::Insensitive), 60);
+    EXPECT_EQ(Text::rfind_any(simple, "qz"sv, Text::Start, Text::End, Text::Step, Text::Case::Insensitive), 60);
+    EXPECT_EQ(Text::find_any(simple, "qz"sv), Text::End);
+}
+
 TEST(RFindAny, SimpleWithView)
 {
     using namespace std::literals;
@@ -471,9 +600,9 @@ TEST(RFindAny, MultipleWithView)
 {
     using namespace std::literals;
     std::string_view simple("simple string with words");
-    auto end = static_cast<int>(simple.length());
-    auto result = 0;
-    std::vector<int> expected{16, 12, 8};
+    auto end = static_cast<Text::Index>(simple.length());
+    Text::Index result = 0;
+    std::vector<Text::Index> expected{16, 12, 8};
     auto needle = "tg"sv;
     for (const auto exp : expected)
     {
@@ -500,3 +629,40 @@ TEST(RFindAny, WithSteps)
     auto result = Text::rfind_any(simple, "sw"sv, Text::Start, -1, 2);
     EXPECT_EQ(result, 14);
 }
+
+TEST(Find, StridedView)
+{
+    using namespace std::literals;
+    // Middle element of every three element record
+    std::string records("xaxxbxxaxxbxxcx");
+    auto column = Text::slice_view(records, 1, Text::End, 3);
+    EXPECT_EQ(Text::find(column, "ab"sv), 0);
+    EXPECT_EQ(Text::find(column, "ab"sv, 1), 2);
+    EXPECT_EQ(Text::find(column, 'c'), 4);
+    EXPECT_EQ(Text::find(column, "ba"sv, Text::Start, Text::End, 2), Text::End);
+    EXPECT_EQ(Text::find(column, "BC"sv, Text::Start, Text::End, Text::Step, Text::Case::Insensitive), 3);
+    EXPECT_EQ(Text::find(column, "x"sv), Text::End);
+    EXPECT_EQ(Text::rfind(column, "ab"sv), 2);
+    EXPECT_EQ(Text::rfind(column, "ab"sv, Text::Start, -2), 0);
+}
+
+TEST(Find, StridedViewMatchesCopy)
+{
+    std::string text;
+    for (size_t idx = 0; idx < 97; ++idx)
+        text += "abc"[(idx * idx + idx / 3) % 3];
+    for (Text::Index stride : {-3, -2, -1, 1, 2, 3})
+    {
+        auto view = Text::slice_view(text, 1, -2, stride);
+        auto copy = Text::slice(text, 1, -2, stride);
+        for (auto needle : {"a", "ab", "bca"})
+            for (Text::Index step : {1, 2, 3})
+                for (Text::Index start : {0, 5, -8})
+                {
+                    EXPECT_EQ(Text::find(view, needle, start, Text::End, step),
+                              Text::find(copy, needle, start, Text::End, step));
+                    EXPECT_EQ(Text::rfind(view, needle, Text::Start, start == 0 ? Text::End : start, step),
+                              Text::rfind(copy, needle, Text::Start, start == 0 ? Text::End : start, step));
+                }
+    }
+}
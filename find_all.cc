@@ -0,0 +1,119 @@
+#include <text_processing/count.hpp>
+#include <text_processing/find_all.hpp>
+
+#include <gtest/gtest.h>
+
+TEST(FindAll, SimpleWithView)
+{
+    using namespace std::literals;
+    auto simple_sv = "simple string with words"sv;
+    auto result = Text::find_all(simple_sv, " ");
+    EXPECT_EQ(result, (std::vector<Text::Index>{6, 13, 18}));
+}
+
+TEST(FindAll, OverlappingAndNonOverlapping)
+{
+    using namespace std::literals;
+    auto text = "aaaa"sv;
+    EXPECT_EQ(Text::find_all(text, "aa"), (std::vector<Text::Index>{0, 1, 2}));
+    EXPECT_EQ(Text::find_all(text, "aa", Text::MatchMode::NonOverlapping), (std::vector<Text::Index>{0, 2}));
+    EXPECT_EQ(Text::find_all(text, "aa", Text::MatchMode::Overlapping, Text::Start, Text::End, -1),
+              (std::vector<Text::Index>{2, 1, 0}));
+    EXPECT_EQ(Text::find_all(text, "aa", Text::MatchMode::NonOverlapping, Text::Start, Text::End, -1),
+              (std::vector<Text::Index>{2, 0}));
+}
+
+TEST(FindAll, SameCountAsCount)
+{
+    using namespace std::literals;
+    auto text = "abababaabbaababab ab aba"sv;
+    for (auto needle : {"a"sv, "ab"sv, "aba"sv, "bab"sv})
+        for (Text::Index step : {1, 2, 3, -1, -2, -3})
+            EXPECT_EQ(static_cast<Text::Index>(
+                          Text::find_all(text, needle, Text::MatchMode::Overlapping, 1, -1, step).size()),
+                      Text::count(text, needle, 1, -1, step))
+                << needle << " " << step;
+}
+
+TEST(FindAll, WithSteps)
+{
+    using namespace std::literals;
+    auto text = "abababab"sv;
+    EXPECT_EQ(Text::find_all(text, "ab", Text::MatchMode::Overlapping, Text::Start, Text::End, 2),
+              (std::vector<Text::Index>{0, 2, 4, 6}));
+    EXPECT_EQ(Text::find_all(text, "ba", Text::MatchMode::Overlapping, Text::Start, Text::End, 2),
+              (std::vector<Text::Index>{}));
+    EXPECT_EQ(Text::find_all(text, "ab", Text::MatchMode::Overlapping, Text::Start, Text::End, -2),
+              (std::vector<Text::Index>{6, 4, 2, 0}));
+}
+
+TEST(FindAll, CaseInsensitiveWithSearcher)
+{
+    using namespace std::literals;
+    auto text = "Word word WORD"sv;
+    Text::Searcher searcher("word"sv, Text::Case::Insensitive);
+    EXPECT_EQ(Text::find_all(text, searcher), (std::vector<Text::Index>{0, 5, 10}));
+    EXPECT_EQ(Text::find_all(text, "word", Text::MatchMode::Overlapping, Text::Start, Text::End, Text::Step,
+                             Text::Case::Insensitive),
+              (std::vector<Text::Index>{0, 5, 10}));
+}
+
+TEST(FindAll, IntoReusedVector)
+{
+    using namespace std::literals;
+    std::vector<Text::Index> positions{42};
+    positions.clear();
+    Text::find_all_into("a,b,c"sv, ',', std::back_inserter(positions));
+    EXPECT_EQ(positions, (std::vector<Text::Index>{1, 3}));
+}
+
+TEST(FindAll, EmptyNeedleAndZeroStep)
+{
+    using namespace std::literals;
+    EXPECT_TRUE(Text::find_all("abc"sv, ""sv).empty());
+    EXPECT_TRUE(Text::find_all("abc"sv, "b", Text::MatchMode::Overlapping, Text::Start, Text::End, 0).empty());
+    EXPECT_TRUE(Text::find_all(""sv, "b").empty());
+}
+
+TEST(FindAllAny, SimpleWithView)
+{
+    using namespace std::literals;
+    auto text = "a,b;c,d"sv;
+    EXPECT_EQ(Text::find_all_any(text, ",;"sv), (std::vector<Text::Index>{1, 3, 5}));
+    EXPECT_EQ(Text::find_all_any(text, ",;"sv, Text::Start, Text::End, -1), (std::vector<Text::Index>{5, 3, 1}));
+    EXPECT_EQ(Text::find_all_any("aBcb"sv, "b"sv, Text::Start, Text::End, Text::Step, Text::Case::Insensitive),
+              (std::vector<Text::Index>{1, 3}));
+}
+
+TEST(FindAllIf, WithSteps)
+{
+    std::vector<int> values{1, 5, 2, 7, 9, 0};
+    auto larger = [](int value) { return value > 4; };
+    EXPECT_EQ(Text::find_all_if(values, larger), (std::vector<Text::Index>{1, 3, 4}));
+    EXPECT_EQ(Text::find_all_if(values, larger, Text::Start, Text::End, 2), (std::vector<Text::Index>{4}));
+    EXPECT_EQ(Text::find_all_if(values, larger, Text::Start, Text::End, -2), (std::vector<Text::Index>{3, 1}));
+}
+
+TEST(Matches, LazyEqualsEager)
+{
+    using namespace std::literals;
+    auto text = "one two one three one"sv;
+    for (auto mode : {Text::MatchMode::Overlapping, Text::MatchMode::NonOverlapping})
+        for (Text::Index step : {1, 2, -1, -3})
+        {
+            auto view = Text::matches(text, "one"sv, mode, Text::Start, Text::End, step);
+            EXPECT_EQ(std::vector<Text::Index>(view.begin(), view.end()),
+                      Text::find_all(text, "one"sv, mode, Text::Start, Text::End, step));
+        }
+}
+
+TEST(Matches, AnyAndIfViews)
+{
+    using namespace std::literals;
+    auto any = Text::matches_any("a b c"sv, " "sv);
+    EXPECT_EQ(std::vector<Text::Index>(any.begin(), any.end()), (std::vector<Text::Index>{1, 3}));
+
+    auto digits = Text::matches_if("a1b22"sv, [](char c) { return c >= '0' && c <= '9'; });
+    EXPECT_EQ(std::vector<Text::Index>(digits.begin(), digits.end()), (std::vector<Text::Index>{1, 3, 4}));
+    EXPECT_EQ(digits.front(), 1);
+}
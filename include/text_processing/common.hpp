@@ -1,8 +1,12 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <cstddef>
+#include <cstdint>
 #include <limits>
-#include <set>
+#include <memory>
+#include <memory_resource>
 #include <string>
 #include <string_view>
 #include <type_traits>
@@ -72,6 +76,13 @@ bool caseless_compare(const T& lhs, const T& rhs)
     return caseless(lhs) == caseless(rhs);
 }
 
+// Allocator given to allocator taking overloads is rebound to every container built with it
+template <typename T, typename Alloc>
+using rebind_alloc = typename std::allocator_traits<Alloc>::template rebind_alloc<T>;
+
+template <typename E, typename Alloc>
+using AllocString = std::basic_string<E, std::char_traits<E>, rebind_alloc<E, Alloc>>;
+
 } // namespace detail
 
 template <typename T>
@@ -84,9 +95,12 @@ template <class T, class U>
 concept SameDataType = std::same_as<container_type_t<T>, container_type_t<U>>;
 
 namespace Text {
-constexpr int Start = 0;
-constexpr int End = std::numeric_limits<int>::max();
-constexpr int Step = 1;
+// Position/step type, signed to allow counting from the end of a text with negative values
+using Index = std::ptrdiff_t;
+
+constexpr Index Start = 0;
+constexpr Index End = std::numeric_limits<Index>::max();
+constexpr Index Step = 1;
 
 enum class Case
 {
@@ -100,8 +114,8 @@ auto to_vector(const std::basic_string_view<T>& container)
     return std::vector<T>(container.cbegin(), container.cend());
 }
 
-template <typename T>
-auto to_vector(const std::vector<std::basic_string_view<T>>& container)
+template <typename T, typename Alloc>
+auto to_vector(const std::vector<std::basic_string_view<T>, Alloc>& container)
 {
     std::vector<std::vector<T>> result;
     result.reserve(container.size());
@@ -110,8 +124,8 @@ auto to_vector(const std::vector<std::basic_string_view<T>>& container)
     return result;
 }
 
-template <typename T>
-auto to_string_vector(const std::vector<std::basic_string_view<T>>& container)
+template <typename T, typename Alloc>
+auto to_string_vector(const std::vector<std::basic_string_view<T>, Alloc>& container)
 {
     std::vector<std::basic_string<T>> result;
     result.reserve(container.size());
@@ -164,17 +178,22 @@ constexpr T clamp(T value, T low_value, T high_value)
     return value;
 }
 
+// Maximum value of narrower index types (like former int based Text::End) is treated as End as well
 template <typename T, typename Value = std::remove_cvref_t<T>>
-constexpr Value sanitize_index(T&& index, size_t text_size)
+    requires std::integral<Value>
+constexpr Index sanitize_index(T&& index, size_t text_size)
 {
-    if (index < Value{0})
-        index = index + static_cast<Value>(text_size);
-    else if (index == Text::End)
-        index = static_cast<Value>(text_size);
-
-    if (text_size == 0 || index != clamp(index, Value{0}, static_cast<Value>(text_size)))
-        return Text::End;
-    return index;
+    auto value = static_cast<Index>(index);
+    if (index == std::numeric_limits<Value>::max())
+        value = static_cast<Index>(text_size);
+    else if (value < 0)
+        value = value + static_cast<Index>(text_size);
+    if constexpr (!std::is_const_v<std::remove_reference_t<T>>)
+        index = static_cast<Value>(value);
+
+    if (text_size == 0 || value != clamp(value, Index{0}, static_cast<Index>(text_size)))
+        return End;
+    return value;
 }
 
 template <typename E>
@@ -232,31 +251,71 @@ Delimiter(const T& container) -> Delimiter<typename std::remove_reference_t<T>::
 template <CStyleArray T>
 Delimiter(const T& array) -> Delimiter<typename std::remove_pointer_t<std::decay_t<T>>>;
 
+// Set of single element delimiters. Byte types use a 256 bit map, other types a sorted flat array.
+// Case folding is resolved at construction by storing every case variant, so lookup is a single probe.
 template <typename E>
 struct Delimiters
 {
-    std::set<E> delimiters;
+    static constexpr bool uses_bitmap = std::is_integral_v<E> && sizeof(E) == 1;
+    std::conditional_t<uses_bitmap, std::array<uint64_t, 4>, std::vector<E>> delimiters{};
+
     explicit constexpr Delimiters(const E* str, Case sensitivity = Case::Sensitive)
-        : delimiters{init_delimiters(str, str + strlen(str), sensitivity)}
-    {}
+    {
+        init_delimiters(str, str + strlen(str), sensitivity);
+    }
     template <typename T>
     explicit constexpr Delimiters(const T& container, Case sensitivity = Case::Sensitive)
-        : delimiters{init_delimiters(container.cbegin(), container.cend(), sensitivity)}
-    {}
+    {
+        init_delimiters(container.cbegin(), container.cend(), sensitivity);
+    }
 
-    std::set<E> init_delimiters(auto begin, auto end, Case sensitivity)
+    constexpr void init_delimiters(auto begin, auto end, Case sensitivity)
     {
-        if (sensitivity == Case::Sensitive)
-            return std::set<E>(begin, end);
-        std::set<E> insensitive;
         for (; begin != end; ++begin)
-            insensitive.insert(detail::caseless(*begin));
-        return insensitive;
+        {
+            if (sensitivity == Case::Sensitive)
+            {
+                insert(*begin);
+                continue;
+            }
+            const E lower = detail::caseless(*begin);
+            insert(lower);
+            if constexpr (detail::RegularChar<E>)
+                if (lower >= 'a' && lower <= 'z')
+                    insert(static_cast<E>(lower - ('a' - 'A')));
+        }
+        if constexpr (!uses_bitmap)
+        {
+            std::sort(delimiters.begin(), delimiters.end());
+            auto equivalent = [](const E& lhs, const E& rhs) { return !(lhs < rhs) && !(rhs < lhs); };
+            delimiters.erase(std::unique(delimiters.begin(), delimiters.end(), equivalent), delimiters.end());
+        }
+    }
+
+    constexpr bool contains(E ch) const
+    {
+        if constexpr (uses_bitmap)
+        {
+            const auto idx = static_cast<uint8_t>(ch);
+            return ((delimiters[idx / 64] >> (idx % 64)) & 1) != 0;
+        }
+        else
+        {
+            auto it = std::lower_bound(delimiters.cbegin(), delimiters.cend(), ch);
+            return it != delimiters.cend() && !(ch < *it);
+        }
     }
 
-    constexpr bool contains(E ch, Case sensitivity = Case::Sensitive) const
+private:
+    constexpr void insert(E ch)
     {
-        return delimiters.contains(sensitivity == Case::Sensitive ? ch : detail::caseless(ch));
+        if constexpr (uses_bitmap)
+        {
+            const auto idx = static_cast<uint8_t>(ch);
+            delimiters[idx / 64] |= uint64_t{1} << (idx % 64);
+        }
+        else
+            delimiters.push_back(ch);
     }
 };
 
@@ -1,11 +1,129 @@
 #pragma once
 
 #include "common.hpp"
+#include "simd.hpp"
+#include "split.hpp"
 
 #include <charconv>
+#include <ranges>
+#include <span>
 #include <stdexcept>
+#include <system_error>
+
+namespace detail {
+
+template <typename R>
+concept SwarInteger = std::integral<R> && !std::same_as<R, bool> && sizeof(R) <= sizeof(uint64_t);
+
+// Decimal std::from_chars for char texts with digits parsed by SWAR kernel: same accepted syntax (optional
+// minus for signed types only), same returned pointer and errors, value is left untouched on failure
+template <SwarInteger R>
+std::from_chars_result parse_integer(const char* first, const char* last, R& value)
+{
+    const auto* current = first;
+    bool negative = false;
+    if constexpr (std::is_signed_v<R>)
+        if (current != last && *current == '-')
+        {
+            negative = true;
+            ++current;
+        }
+
+    uint64_t magnitude = 0;
+    bool overflow = false;
+    const auto* digits_end = reinterpret_cast<const char*>(simd::parse_digits(
+        reinterpret_cast<const uint8_t*>(current), reinterpret_cast<const uint8_t*>(last), magnitude, overflow));
+    if (digits_end == current)
+        return {first, std::errc::invalid_argument};
+
+    const auto limit = static_cast<uint64_t>(std::numeric_limits<R>::max()) + (negative ? 1 : 0);
+    if (overflow || magnitude > limit)
+        return {digits_end, std::errc::result_out_of_range};
+    value = static_cast<R>(negative ? 0 - magnitude : magnitude);
+    return {digits_end, std::errc()};
+}
+
+} // namespace detail
 
 namespace Text {
+// Result of a non-throwing conversion. Offset is the first element not consumed by parsing, for a failed
+// conversion it points where parsing stopped.
+template <typename R>
+struct Converted
+{
+    R value{};
+    std::errc error{};
+    Index offset = 0;
+
+    bool ok() const
+    {
+        return error == std::errc();
+    }
+
+    explicit operator bool() const
+    {
+        return ok();
+    }
+};
+
+// Field that failed to convert, its slot in output is left value initialized. Position is an index in split
+// text, or an offset in the element for batch conversion.
+struct FieldError
+{
+    size_t field = 0;
+    Index position = 0;
+    std::errc error{};
+
+    bool operator==(const FieldError&) const = default;
+};
+
+template <typename R>
+struct BatchConverted
+{
+    std::vector<R> values;
+    std::vector<FieldError> errors;
+
+    bool ok() const
+    {
+        return errors.empty();
+    }
+};
+
+template <typename R, typename TextSrc>
+Converted<R> try_convert(const TextSrc& element)
+{
+    Converted<R> result;
+    Text t{element};
+    using E = std::remove_cv_t<std::remove_pointer_t<decltype(t.ptr)>>;
+    std::from_chars_result parsed;
+    if constexpr (detail::SwarInteger<R> && std::same_as<E, char>)
+        parsed = detail::parse_integer(t.ptr, t.ptr + t.length, result.value);
+    else
+        parsed = std::from_chars(t.ptr, t.ptr + t.length, result.value);
+    auto [ptr, ec] = parsed;
+    result.error = ec;
+    result.offset = static_cast<Index>(ptr - t.ptr);
+    if (ec != std::errc())
+        result.value = R{};
+    return result;
+}
+
+// Converts every element, failed ones are value initialized and listed in errors
+template <typename R, typename TextSrc>
+BatchConverted<R> try_convert(const std::vector<TextSrc>& container)
+{
+    BatchConverted<R> result;
+    result.values.reserve(container.size());
+    for (const auto& elem : container)
+    {
+        auto converted = try_convert<R>(elem);
+        if (!converted)
+            result.errors.push_back({result.values.size(), converted.offset, converted.error});
+        result.values.push_back(converted.value);
+    }
+    return result;
+}
+
 template <typename R, typename TextSrc>
 auto convert(const std::vector<TextSrc>& container)
 {
@@ -14,12 +132,10 @@ auto convert(const std::vector<TextSrc>& container)
     result.reserve(container.size());
     for (const auto& elem : container)
     {
-        R val{};
-        Text t{elem};
-        auto [ptr, ec] = std::from_chars(t.ptr, t.ptr + t.length, val);
-        if (ec != std::errc())
+        auto converted = try_convert<R>(elem);
+        if (!converted)
             throw std::runtime_error("Invalid value passed to convert: "s + std::string(elem));
-        result.emplace_back(val);
+        result.emplace_back(converted.value);
     }
     return result;
 }
@@ -28,12 +144,210 @@ template <typename R, typename TextSrc>
 auto convert(const TextSrc& element)
 {
     using namespace std::literals;
-    R result{};
-    Text t{element};
-    auto [ptr, ec] = std::from_chars(t.ptr, t.ptr + t.length, result);
-    if (ec != std::errc())
+    auto converted = try_convert<R>(element);
+    if (!converted)
         throw std::runtime_error("Invalid value passed to convert: "s + std::string(element));
+    return converted.value;
+}
+
+struct ConvertResult
+{
+    // Number of fields stored in output, failed ones included
+    size_t count = 0;
+    // Text has more fields than output can hold
+    bool truncated = false;
+    std::vector<FieldError> errors;
+
+    bool ok() const
+    {
+        return !truncated && errors.empty();
+    }
+};
+
+} // namespace Text
+
+namespace detail {
+
+// Tokenizes and parses in the same pass, store(index, value) returns false when output is full
+template <typename R, typename Matcher, typename Store>
+Text::ConvertResult split_convert_all(Splitter<char, Matcher> splitter, const char* text, Store store)
+{
+    Text::ConvertResult result;
+    for (auto cursor = splitter.begin(); cursor.stage != SplitCursor<char>::Stage::Done; splitter.advance(cursor))
+    {
+        const auto field = cursor.fragment;
+        auto converted = Text::try_convert<R>(field);
+        if (!converted)
+            result.errors.push_back({result.count, static_cast<Text::Index>(field.data() - text), converted.error});
+        if (!store(result.count, converted.value))
+        {
+            if (!result.errors.empty() && result.errors.back().field == result.count)
+                result.errors.pop_back();
+            result.truncated = true;
+            break;
+        }
+        ++result.count;
+    }
     return result;
 }
 
-}
\ No newline at end of file
+template <typename R>
+auto span_store(std::span<R> out)
+{
+    return [out](size_t index, const R& value) {
+        if (index >= out.size())
+            return false;
+        out[index] = value;
+        return true;
+    };
+}
+
+template <typename R>
+auto vector_store(std::vector<R>& out)
+{
+    out.clear();
+    return [&out](size_t, const R& value) {
+        out.push_back(value);
+        return true;
+    };
+}
+
+} // namespace detail
+
+namespace Text {
+
+// Splits text and converts every field with std::from_chars without building intermediate containers.
+// Invalid fields do not throw, they are reported in ConvertResult::errors. Output span is filled until it is
+// full, a vector is cleared and grows as needed (its capacity is reused).
+template <typename R, typename TextSrc, typename DelimSrc>
+    requires CanBeDelimiterOf<DelimSrc, TextSrc> && std::same_as<container_type_t<TextSrc>, char>
+ConvertResult split_convert(const TextSrc& t, const DelimSrc& d, std::span<R> out,
+                            SplitBehavior beh = SplitBehavior::KeepEmpty, Index start = Start, Index end = End,
+                            Index step = Step, Case sensitivity = Case::Sensitive)
+{
+    using Matcher = detail::NeedleMatcher<char, DelimSrc>;
+    Text text(t);
+    return detail::split_convert_all<R>(
+        detail::Splitter<char, Matcher>(text.ptr, text.length, Matcher(d, sensitivity), beh, start, end, step),
+        text.ptr, detail::span_store(out));
+}
+
+template <typename R, typename TextSrc, typename DelimSrc>
+    requires CanBeDelimiterOf<DelimSrc, TextSrc> && std::same_as<container_type_t<TextSrc>, char>
+ConvertResult split_convert(const TextSrc& t, const DelimSrc& d, std::vector<R>& out,
+                            SplitBehavior beh = SplitBehavior::KeepEmpty, Index start = Start, Index end = End,
+                            Index step = Step, Case sensitivity = Case::Sensitive)
+{
+    using Matcher = detail::NeedleMatcher<char, DelimSrc>;
+    Text text(t);
+    return detail::split_convert_all<R>(
+        detail::Splitter<char, Matcher>(text.ptr, text.length, Matcher(d, sensitivity), beh, start, end, step),
+        text.ptr, detail::vector_store(out));
+}
+
+template <typename R, typename TextSrc, typename DelimSrc>
+    requires CanBeDelimiterOf<DelimSrc, TextSrc> && std::same_as<container_type_t<TextSrc>, char>
+ConvertResult split_convert_any(const TextSrc& t, const DelimSrc& d, std::span<R> out,
+                                SplitBehavior beh = SplitBehavior::KeepEmpty, Index start = Start, Index end = End,
+                                Index step = Step, Case sensitivity = Case::Sensitive)
+{
+    using Matcher = detail::AnyMatcher<char, DelimSrc>;
+    Text text(t);
+    return detail::split_convert_all<R>(
+        detail::Splitter<char, Matcher>(text.ptr, text.length, Matcher(d, sensitivity), beh, start, end, step),
+        text.ptr, detail::span_store(out));
+}
+
+template <typename R, typename TextSrc, typename DelimSrc>
+    requires CanBeDelimiterOf<DelimSrc, TextSrc> && std::same_as<container_type_t<TextSrc>, char>
+ConvertResult split_convert_any(const TextSrc& t, const DelimSrc& d, std::vector<R>& out,
+                                SplitBehavior beh = SplitBehavior::KeepEmpty, Index start = Start, Index end = End,
+                                Index step = Step, Case sensitivity = Case::Sensitive)
+{
+    using Matcher = detail::AnyMatcher<char, DelimSrc>;
+    Text text(t);
+    return detail::split_convert_all<R>(
+        detail::Splitter<char, Matcher>(text.ptr, text.length, Matcher(d, sensitivity), beh, start, end, step),
+        text.ptr, detail::vector_store(out));
+}
+
+// Types formatted with std::to_chars by format_into and join_numbers
+template <typename T>
+concept Number = std::is_arithmetic_v<T> && !std::same_as<T, bool>;
+
+// Upper bound of characters std::to_chars writes for a value in its default (shortest round trip) format:
+// sign and all digits for integers, sign, max_digits10 digits, point and exponent for floating point types
+template <Number T>
+constexpr size_t max_chars()
+{
+    using Limits = std::numeric_limits<T>;
+    if constexpr (std::is_integral_v<T>)
+        return static_cast<size_t>(Limits::digits10) + 1 + std::is_signed_v<T>;
+    else
+    {
+        size_t exponent_digits = 0;
+        for (auto exponent = Limits::max_digits10 - Limits::min_exponent10; exponent > 0; exponent /= 10)
+            ++exponent_digits;
+        return 1 + static_cast<size_t>(Limits::max_digits10) + 1 + 2 + exponent_digits;
+    }
+}
+
+// Appends a number formatted with std::to_chars, inverse of convert
+template <typename StringAlloc, Number T>
+std::basic_string<char, std::char_traits<char>, StringAlloc>& format_into(
+    std::basic_string<char, std::char_traits<char>, StringAlloc>& out, T value)
+{
+    const auto offset = out.size();
+    out.resize(offset + max_chars<T>());
+    const auto result = std::to_chars(out.data() + offset, out.data() + out.size(), value);
+    out.resize(static_cast<size_t>(result.ptr - out.data()));
+    return out;
+}
+
+// Appends numbers separated with a delimiter (like join). Output grows once to an upper bound of the result
+// size, numbers are written in place and the string is shrunk to what was written.
+template <typename StringAlloc, std::ranges::forward_range R, typename DelimSrc>
+    requires Number<std::ranges::range_value_t<R>> && CanBeDelimiterOf<DelimSrc, std::string_view>
+std::basic_string<char, std::char_traits<char>, StringAlloc>& format_into(
+    std::basic_string<char, std::char_traits<char>, StringAlloc>& out, R&& values, DelimSrc d)
+{
+    const auto count = static_cast<size_t>(std::ranges::distance(values));
+    if (count == 0)
+        return out;
+    Delimiter delimiter(d);
+    const auto offset = out.size();
+    out.resize(offset + count * max_chars<std::ranges::range_value_t<R>>() + (count - 1) * delimiter.length);
+    auto* ptr = out.data() + offset;
+    auto* last = out.data() + out.size();
+    bool first = true;
+    for (const auto& value : values)
+    {
+        if (!first)
+        {
+            std::char_traits<char>::copy(ptr, delimiter.ptr, delimiter.length);
+            ptr += delimiter.length;
+        }
+        first = false;
+        ptr = std::to_chars(ptr, last, value).ptr;
+    }
+    out.resize(static_cast<size_t>(ptr - out.data()));
+    return out;
+}
+
+template <typename Alloc, std::ranges::forward_range R, typename DelimSrc>
+    requires Number<std::ranges::range_value_t<R>> && CanBeDelimiterOf<DelimSrc, std::string_view>
+auto join_numbers(std::allocator_arg_t, const Alloc& alloc, R&& values, DelimSrc d)
+{
+    detail::AllocString<char, Alloc> result(alloc);
+    format_into(result, std::forward<R>(values), d);
+    return result;
+}
+
+template <std::ranges::forward_range R, typename DelimSrc>
+    requires Number<std::ranges::range_value_t<R>> && CanBeDelimiterOf<DelimSrc, std::string_view>
+std::string join_numbers(R&& values, DelimSrc d)
+{
+    return join_numbers(std::allocator_arg, std::allocator<char>(), std::forward<R>(values), d);
+}
+
+} // namespace Text
@@ -5,38 +5,126 @@
 #include "sub.hpp"
 
 namespace Text {
+// Counts every match (overlapping ones too) starting on step lattice. Lattice for a negative step starts from
+// the last position a needle fits before end, like in rfind.
 template <typename TextSrc, typename NeedleSrc>
     requires CanBeDelimiterOf<NeedleSrc, TextSrc>
-int count(const TextSrc& t, const NeedleSrc& n, int start = Start, int end = End, int step = Step,
-          Case sensitivity = Case::Sensitive)
+Index count(const TextSrc& t, const NeedleSrc& n, Index start = Start, Index end = End, Index step = Step,
+            Case sensitivity = Case::Sensitive)
 {
-    int cnt = 0;
-    start -= step;
-    while ((start = find(t, n, start + step, end, step, sensitivity)) != End)
-        ++cnt;
+    if (step == 0)
+        return 0;
+
+    Text text(t);
+    Delimiter needle(n);
+
+    if (needle.length == 0)
+        return 0;
+
+    if (sanitize_index(start, text.length) == End || sanitize_index(end, text.length) == End)
+        return 0;
+    if (start >= end || static_cast<size_t>(end - start) < needle.length)
+        return 0;
+
+    auto pattern = detail::pattern_of(n, needle, sensitivity);
+    if (step == 1 || step == -1)
+        return static_cast<Index>(pattern.count_in(text.ptr + start, text.ptr + end));
+
+    Index cnt = 0;
+    if (step > 0)
+    {
+        for (auto current = text.ptr + start; current + needle.length <= text.ptr + end; current += step)
+            cnt += pattern.matches(current);
+    }
+    else
+    {
+        for (auto pos = end - static_cast<Index>(needle.length); pos >= start; pos += step)
+            cnt += pattern.matches(text.ptr + pos);
+    }
+    return cnt;
+}
+
+template <typename E, typename NeedleSrc>
+    requires CanBeDelimiterOf<NeedleSrc, StridedView<E>>
+Index count(const StridedView<E>& t, const NeedleSrc& n, Index start = Start, Index end = End, Index step = Step,
+            Case sensitivity = Case::Sensitive)
+{
+    if (t.contiguous())
+        return count(t.view(), n, start, end, step, sensitivity);
+    if (step == 0)
+        return 0;
+
+    Delimiter needle(n);
+    if (needle.length == 0)
+        return 0;
+    if (sanitize_index(start, t.size()) == End || sanitize_index(end, t.size()) == End)
+        return 0;
+
+    auto pattern = detail::pattern_of(n, needle, sensitivity);
+    const auto length = static_cast<Index>(needle.length);
+    Index cnt = 0;
+    for (auto pos = step < 0 ? end - length : start; pos >= start && pos + length <= end; pos += step)
+        cnt += pattern.matches_at(t.begin() + pos);
     return cnt;
 }
 
 template <typename TextSrc, typename Predicate>
-int count_if(const TextSrc& t, Predicate pred, int start = Start, int end = End, int step = Step)
+Index count_if(const TextSrc& t, Predicate pred, Index start = Start, Index end = End, Index step = Step)
 {
-    int cnt = 0;
-    start -= step;
-    while ((start = find_if(t, pred, start + step, end, step)) != End)
-        ++cnt;
+    if (step == 0)
+        return 0;
+
+    Text text(t);
+
+    if (sanitize_index(start, text.length) == End || sanitize_index(end, text.length) == End)
+        return 0;
+
+    Index cnt = 0;
+    if (step > 0)
+    {
+        for (auto pos = start; pos < end; pos += step)
+            cnt += static_cast<bool>(pred(text.ptr[pos]));
+    }
+    else
+    {
+        for (auto pos = end - 1; pos >= start; pos += step)
+            cnt += static_cast<bool>(pred(text.ptr[pos]));
+    }
     return cnt;
 }
 
 template <typename TextSrc, typename NeedleSrc>
     requires CanBeDelimiterOf<NeedleSrc, TextSrc>
-int count_any(const TextSrc& t, const NeedleSrc& d, int start = Start, int end = End, int step = Step,
-              Case sensitivity = Case::Sensitive)
+Index count_any(const TextSrc& t, const NeedleSrc& d, Index start = Start, Index end = End, Index step = Step,
+                Case sensitivity = Case::Sensitive)
 {
-    int cnt = 0;
-    start -= step;
-    while ((start = find_any(t, d, start + step, end, step, sensitivity)) != End)
-        ++cnt;
+    if (step == 0)
+        return 0;
+
+    Text text(t);
+    const auto& delimiters = detail::delimiters_of(d, sensitivity);
+
+    if (sanitize_index(start, text.length) == End || sanitize_index(end, text.length) == End)
+        return 0;
+    if (start >= end)
+        return 0;
+
+    auto pattern = detail::any_pattern_of(d, delimiters);
+    if (step == 1 || step == -1)
+        return static_cast<Index>(pattern.count_in(text.ptr + start, text.ptr + end));
+
+    Index cnt = 0;
+    if (step > 0)
+    {
+        for (auto pos = start; pos < end; pos += step)
+            cnt += pattern.contains(text.ptr[pos]);
+    }
+    else
+    {
+        for (auto pos = end - 1; pos >= start; pos += step)
+            cnt += pattern.contains(text.ptr[pos]);
+    }
     return cnt;
 }
 
-} // namespace Text
\ No newline at end of file
+} // namespace Text
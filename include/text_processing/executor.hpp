@@ -0,0 +1,197 @@
+#pragma once
+
+#include "common.hpp"
+
+#include <atomic>
+#include <concepts>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace detail {
+
+// Runs f(0) ... f(tasks - 1), each on its own thread (the first one on the calling thread), rethrows first error
+template <typename F>
+void parallel_for(size_t tasks, F f)
+{
+    std::vector<std::exception_ptr> errors(tasks);
+    auto run = [&](size_t task) {
+        try
+        {
+            f(task);
+        }
+        catch (...)
+        {
+            errors[task] = std::current_exception();
+        }
+    };
+    std::vector<std::thread> threads;
+    threads.reserve(tasks);
+    for (size_t task = 1; task < tasks; ++task)
+        threads.emplace_back(run, task);
+    run(0);
+    for (auto& thread : threads)
+        thread.join();
+    for (auto& error : errors)
+        if (error)
+            std::rethrow_exception(error);
+}
+
+} // namespace detail
+
+namespace Text {
+
+// Executor runs bulk(tasks, f) as f(0) ... f(tasks - 1), possibly concurrently, and returns once all of them
+// finished (rethrowing an error of any of them). Tasks are started in index order, so early tasks finish first.
+template <typename T>
+concept Executor = requires(T& executor, void (*task)(size_t)) {
+                       {
+                           executor.concurrency()
+                           } -> std::convertible_to<size_t>;
+                       executor.bulk(size_t{}, task);
+                   };
+
+// Runs tasks one after another on the calling thread
+struct SequentialExecutor
+{
+    size_t concurrency() const
+    {
+        return 1;
+    }
+
+    template <typename F>
+    void bulk(size_t tasks, F&& f)
+    {
+        for (size_t task = 0; task < tasks; ++task)
+            f(task);
+    }
+};
+
+// Fixed set of worker threads, the thread calling bulk works on the tasks as well. One bulk call runs at a time,
+// calling bulk from inside a task is not supported. Threads sleep on atomic waits between bulk calls.
+class ThreadPool
+{
+public:
+    explicit ThreadPool(size_t threads = std::max(1u, std::thread::hardware_concurrency()))
+    {
+        workers_.reserve(threads > 0 ? threads - 1 : 0);
+        for (size_t idx = 1; idx < threads; ++idx)
+            workers_.emplace_back([this] { work(); });
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard lock(mutex_);
+            stop_ = true;
+        }
+        ++generation_;
+        generation_.notify_all();
+        for (auto& worker : workers_)
+            worker.join();
+    }
+
+    size_t concurrency() const
+    {
+        return workers_.size() + 1;
+    }
+
+    template <typename F>
+    void bulk(size_t tasks, F&& f)
+    {
+        if (tasks == 0)
+            return;
+        std::lock_guard serial(bulk_mutex_);
+        Job job{tasks, const_cast<void*>(static_cast<const void*>(std::addressof(f))),
+                [](void* fn, size_t task) { (*static_cast<std::remove_reference_t<F>*>(fn))(task); }};
+        job.remaining = tasks;
+        {
+            std::lock_guard lock(mutex_);
+            job_ = &job;
+        }
+        ++generation_;
+        generation_.notify_all();
+        run(job);
+
+        for (auto left = job.remaining.load(); left != 0; left = job.remaining.load())
+            job.remaining.wait(left);
+        // No worker picks the job up anymore, the ones that did have to leave it before it is destroyed
+        {
+            std::lock_guard lock(mutex_);
+            job_ = nullptr;
+        }
+        for (auto busy = active_.load(); busy != 0; busy = active_.load())
+            active_.wait(busy);
+        if (job.error)
+            std::rethrow_exception(job.error);
+    }
+
+private:
+    struct Job
+    {
+        size_t tasks;
+        void* fn;
+        void (*invoke)(void*, size_t);
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> remaining{0};
+        std::exception_ptr error{};
+    };
+
+    void run(Job& job)
+    {
+        for (size_t task = job.next++; task < job.tasks; task = job.next++)
+        {
+            try
+            {
+                job.invoke(job.fn, task);
+            }
+            catch (...)
+            {
+                std::lock_guard lock(mutex_);
+                if (!job.error)
+                    job.error = std::current_exception();
+            }
+            if (--job.remaining == 0)
+                job.remaining.notify_all();
+        }
+    }
+
+    void work()
+    {
+        size_t seen = 0;
+        for (;;)
+        {
+            generation_.wait(seen);
+            Job* job = nullptr;
+            {
+                std::lock_guard lock(mutex_);
+                if (stop_)
+                    return;
+                seen = generation_.load();
+                job = job_;
+                if (job != nullptr)
+                    ++active_;
+            }
+            if (job == nullptr)
+                continue;
+            run(*job);
+            if (--active_ == 0)
+                active_.notify_all();
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    std::mutex bulk_mutex_;
+    std::mutex mutex_;
+    Job* job_ = nullptr;
+    bool stop_ = false;
+    std::atomic<size_t> generation_{0};
+    std::atomic<size_t> active_{0};
+};
+
+} // namespace Text
@@ -1,11 +1,13 @@
 #pragma once
 
 #include "common.hpp"
+#include "searcher.hpp"
+#include "sub.hpp"
 
 namespace Text {
 template <typename TextSrc, typename NeedleSrc>
     requires CanBeDelimiterOf<NeedleSrc, TextSrc> && std::equality_comparable<container_type_t<TextSrc>>
-int find_impl(const TextSrc& t, const NeedleSrc& n, int start, int end, int step, Case sensitivity)
+Index find_impl(const TextSrc& t, const NeedleSrc& n, Index start, Index end, Index step, Case sensitivity)
 {
     if (step == 0)
         return End;
@@ -19,37 +21,79 @@ int find_impl(const TextSrc& t, const NeedleSrc& n, int start, int end, int step
     if (sanitize_index(start, text.length) == End || sanitize_index(end, text.length) == End)
         return End;
 
+    auto pattern = detail::pattern_of(n, needle, sensitivity);
+    if (step == 1 || step == -1)
+    {
+        const auto* first = step == 1 ? text.ptr + start : text.ptr;
+        const auto* found =
+            step == 1 ? pattern.find_in(first, text.ptr + end) : pattern.rfind_in(first, text.ptr + end);
+        return found == text.ptr + end ? End : static_cast<Index>(found - text.ptr);
+    }
+
     auto current = step < 0 ? text.ptr + end - needle.length : text.ptr + start;
     while (current + needle.length <= text.ptr + end && current >= text.ptr)
     {
-        if (!are_equal(current, needle.ptr, needle.length, sensitivity))
+        if (!pattern.matches(current))
         {
             current += step;
             continue;
         }
-        return static_cast<int>(current - text.ptr);
+        return static_cast<Index>(current - text.ptr);
     }
     return End;
 }
 
 template <typename TextSrc, typename NeedleSrc>
     requires CanBeDelimiterOf<NeedleSrc, TextSrc>
-int find(const TextSrc& t, const NeedleSrc& n, int start = Start, int end = End, int step = Step,
-         Case sensitivity = Case::Sensitive)
+Index find(const TextSrc& t, const NeedleSrc& n, Index start = Start, Index end = End, Index step = Step,
+           Case sensitivity = Case::Sensitive)
 {
     return find_impl(t, n, start, end, step, sensitivity);
 }
 
 template <typename TextSrc, typename NeedleSrc>
     requires CanBeDelimiterOf<NeedleSrc, TextSrc>
-int rfind(const TextSrc& t, const NeedleSrc& n, int start = Start, int end = End, int step = Step,
-          Case sensitivity = Case::Sensitive)
+Index rfind(const TextSrc& t, const NeedleSrc& n, Index start = Start, Index end = End, Index step = Step,
+            Case sensitivity = Case::Sensitive)
 {
     return find_impl(t, n, start, end, -step, sensitivity);
 }
 
+// Same lattice as find_impl, elements of a strided view are compared one by one unless they are contiguous
+template <typename E, typename NeedleSrc>
+    requires CanBeDelimiterOf<NeedleSrc, StridedView<E>>
+Index find(const StridedView<E>& t, const NeedleSrc& n, Index start = Start, Index end = End, Index step = Step,
+           Case sensitivity = Case::Sensitive)
+{
+    if (t.contiguous())
+        return find_impl(t.view(), n, start, end, step, sensitivity);
+    if (step == 0)
+        return End;
+
+    Delimiter needle(n);
+    if (needle.length == 0)
+        return End;
+    if (sanitize_index(start, t.size()) == End || sanitize_index(end, t.size()) == End)
+        return End;
+
+    auto pattern = detail::pattern_of(n, needle, sensitivity);
+    const auto length = static_cast<Index>(needle.length);
+    for (auto pos = step < 0 ? end - length : start; pos >= 0 && pos + length <= end; pos += step)
+        if (pattern.matches_at(t.begin() + pos))
+            return pos;
+    return End;
+}
+
+template <typename E, typename NeedleSrc>
+    requires CanBeDelimiterOf<NeedleSrc, StridedView<E>>
+Index rfind(const StridedView<E>& t, const NeedleSrc& n, Index start = Start, Index end = End, Index step = Step,
+            Case sensitivity = Case::Sensitive)
+{
+    return find(t, n, start, end, -step, sensitivity);
+}
+
 template <typename TextSrc, typename Predicate>
-int find_if_impl(const TextSrc& t, Predicate pred, int start, int end, int step)
+Index find_if_impl(const TextSrc& t, Predicate pred, Index start, Index end, Index step)
 {
     if (step == 0)
         return End;
@@ -60,68 +104,76 @@ int find_if_impl(const TextSrc& t, Predicate pred, int start, int end, int step)
         return End;
 
     const auto* current = step < 0 ? text.ptr + end - 1 : text.ptr + start;
-    while (current < text.ptr + text.length && current >= text.ptr)
+    while (current < text.ptr + end && current >= text.ptr)
     {
         if (!pred(*current))
         {
             current += step;
             continue;
         }
-        return static_cast<int>(current - text.ptr);
+        return static_cast<Index>(current - text.ptr);
     }
     return End;
 }
 
 template <typename TextSrc, typename Predicate>
-int find_if(const TextSrc& t, Predicate pred, int start = Start, int end = End, int step = Step)
+Index find_if(const TextSrc& t, Predicate pred, Index start = Start, Index end = End, Index step = Step)
 {
     return find_if_impl(t, pred, start, end, step);
 }
 
 template <typename TextSrc, typename Predicate>
-int rfind_if(const TextSrc& t, Predicate pred, int start = Start, int end = End, int step = Step)
+Index rfind_if(const TextSrc& t, Predicate pred, Index start = Start, Index end = End, Index step = Step)
 {
     return find_if_impl(t, pred, start, end, -step);
 }
 
 template <typename TextSrc, typename NeedleSrc>
     requires CanBeDelimiterOf<NeedleSrc, TextSrc>
-int find_any_impl(const TextSrc& t, const NeedleSrc& d, int start, int end, int step, Case sensitivity)
+Index find_any_impl(const TextSrc& t, const NeedleSrc& d, Index start, Index end, Index step, Case sensitivity)
 {
     if (step == 0)
         return End;
 
     Text text(t);
-    Delimiters delimiters(d, sensitivity);
+    const auto& delimiters = detail::delimiters_of(d, sensitivity);
 
     if (sanitize_index(start, text.length) == End || sanitize_index(end, text.length) == End)
         return End;
 
+    auto pattern = detail::any_pattern_of(d, delimiters);
+    if (step == 1 || step == -1)
+    {
+        const auto* found = step == 1 ? pattern.find_in(text.ptr + start, text.ptr + end)
+                                      : pattern.rfind_in(text.ptr, text.ptr + end);
+        return found == text.ptr + end ? End : static_cast<Index>(found - text.ptr);
+    }
+
     auto current = step < 0 ? text.ptr + end - 1 : text.ptr + start;
-    while (current < text.ptr + text.length && current >= text.ptr)
+    while (current < text.ptr + end && current >= text.ptr)
     {
-        if (!delimiters.contains(*current, sensitivity))
+        if (!pattern.contains(*current))
         {
             current += step;
             continue;
         }
-        return static_cast<int>(current - text.ptr);
+        return static_cast<Index>(current - text.ptr);
     }
     return End;
 }
 
 template <typename TextSrc, typename NeedleSrc>
     requires CanBeDelimiterOf<NeedleSrc, TextSrc>
-int find_any(const TextSrc& t, const NeedleSrc& d, int start = Start, int end = End, int step = Step,
-             Case sensitivity = Case::Sensitive)
+Index find_any(const TextSrc& t, const NeedleSrc& d, Index start = Start, Index end = End, Index step = Step,
+               Case sensitivity = Case::Sensitive)
 {
     return find_any_impl(t, d, start, end, step, sensitivity);
 }
 
 template <typename TextSrc, typename NeedleSrc>
     requires CanBeDelimiterOf<NeedleSrc, TextSrc>
-int rfind_any(const TextSrc& t, const NeedleSrc& d, int start = Start, int end = End, int step = Step,
-              Case sensitivity = Case::Sensitive)
+Index rfind_any(const TextSrc& t, const NeedleSrc& d, Index start = Start, Index end = End, Index step = Step,
+                Case sensitivity = Case::Sensitive)
 {
     return find_any_impl(t, d, start, end, -step, sensitivity);
 }
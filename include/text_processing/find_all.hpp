@@ -0,0 +1,290 @@
+#pragma once
+
+#include "common.hpp"
+#include "split.hpp"
+
+#include <iterator>
+#include <ranges>
+#include <vector>
+
+namespace Text {
+
+enum class MatchMode
+{
+    Overlapping,
+    NonOverlapping
+};
+
+} // namespace Text
+
+namespace detail {
+
+// Position of the last reported match and lattice position the scan continues from
+struct MatchCursor
+{
+    Text::Index position = Text::End;
+    Text::Index candidate = 0;
+
+    bool operator==(const MatchCursor& other) const
+    {
+        return position == other.position;
+    }
+};
+
+// Match scan shared by eager find_all functions and lazy match views. Lattice of a negative step starts from
+// the last position a match fits before end, like in count and rfind. Non-overlapping scan continues on the
+// same lattice after the whole match.
+template <typename E, typename Matcher>
+class MatchScanner
+{
+public:
+    MatchScanner(const E* ptr, size_t length, Matcher matcher, Text::MatchMode mode, Text::Index start,
+                 Text::Index end, Text::Index step)
+        : matcher_(std::move(matcher))
+        , ptr_(ptr)
+        , mode_(mode)
+        , start_(start)
+        , end_(end)
+        , step_(step)
+    {
+        if (length == 0 || step_ == 0 || matcher_.size() == 0)
+            return;
+        valid_ = Text::sanitize_index(start_, length) != Text::End && Text::sanitize_index(end_, length) != Text::End;
+    }
+
+    MatchCursor begin()
+    {
+        MatchCursor cursor;
+        if (!valid_)
+            return cursor;
+        cursor.candidate = step_ > 0 ? start_ : end_ - static_cast<Text::Index>(matcher_.size());
+        advance(cursor);
+        return cursor;
+    }
+
+    void advance(MatchCursor& cursor)
+    {
+        cursor.position = Text::End;
+        if (step_ > 0)
+        {
+            if (cursor.candidate >= end_)
+                return;
+            const auto* found = matcher_.next(ptr_ + cursor.candidate, ptr_ + end_, step_);
+            if (!found)
+                return;
+            cursor.position = found - ptr_;
+            cursor.candidate = cursor.position + skip_after(matcher_.size());
+        }
+        else
+        {
+            if (cursor.candidate < start_)
+                return;
+            const auto* found = matcher_.prev(ptr_ + start_, ptr_ + cursor.candidate, -step_);
+            if (!found)
+                return;
+            cursor.position = found - ptr_;
+            cursor.candidate = cursor.position - skip_after(matcher_.size());
+        }
+    }
+
+private:
+    Text::Index skip_after(size_t match_length) const
+    {
+        const auto step = step_ > 0 ? step_ : -step_;
+        const auto length = static_cast<Text::Index>(match_length);
+        if (mode_ == Text::MatchMode::Overlapping || length <= step)
+            return step;
+        return (length + step - 1) / step * step;
+    }
+
+    Matcher matcher_;
+    const E* ptr_;
+    Text::MatchMode mode_;
+    Text::Index start_;
+    Text::Index end_;
+    Text::Index step_;
+    bool valid_ = false;
+};
+
+template <typename E, typename Matcher, typename OutputIt>
+OutputIt find_all_into(MatchScanner<E, Matcher> scanner, OutputIt out)
+{
+    for (auto cursor = scanner.begin(); cursor.position != Text::End; scanner.advance(cursor))
+        *out++ = cursor.position;
+    return out;
+}
+
+} // namespace detail
+
+namespace Text {
+
+// Lazy sequence of match positions, in scan order (descending for a negative step). Like SplitView, end
+// iterator has the same type as begin and text and needle have to outlive the view.
+template <typename E, typename Matcher>
+class MatchView : public std::ranges::view_interface<MatchView<E, Matcher>>
+{
+public:
+    class iterator
+    {
+    public:
+        using value_type = Index;
+        using difference_type = std::ptrdiff_t;
+        using iterator_concept = std::forward_iterator_tag;
+
+        iterator() = default;
+        iterator(detail::MatchScanner<E, Matcher>* scanner, detail::MatchCursor cursor)
+            : scanner_(scanner)
+            , cursor_(cursor)
+        {}
+
+        value_type operator*() const
+        {
+            return cursor_.position;
+        }
+
+        iterator& operator++()
+        {
+            scanner_->advance(cursor_);
+            return *this;
+        }
+
+        iterator operator++(int)
+        {
+            auto copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        bool operator==(const iterator& other) const
+        {
+            return cursor_ == other.cursor_;
+        }
+
+    private:
+        detail::MatchScanner<E, Matcher>* scanner_ = nullptr;
+        detail::MatchCursor cursor_;
+    };
+
+    explicit MatchView(detail::MatchScanner<E, Matcher> scanner)
+        : scanner_(std::move(scanner))
+    {}
+
+    iterator begin()
+    {
+        return iterator(&scanner_, scanner_.begin());
+    }
+
+    iterator end()
+    {
+        return iterator(&scanner_, {});
+    }
+
+private:
+    detail::MatchScanner<E, Matcher> scanner_;
+};
+
+template <typename TextSrc, typename NeedleSrc>
+    requires CanBeDelimiterOf<NeedleSrc, TextSrc>
+auto matches(const TextSrc& t, const NeedleSrc& n, MatchMode mode = MatchMode::Overlapping, Index start = Start,
+             Index end = End, Index step = Step, Case sensitivity = Case::Sensitive)
+{
+    using E = container_type_t<TextSrc>;
+    using Matcher = detail::NeedleMatcher<E, NeedleSrc>;
+    Text text(t);
+    return MatchView<E, Matcher>(
+        detail::MatchScanner<E, Matcher>(text.ptr, text.length, Matcher(n, sensitivity), mode, start, end, step));
+}
+
+// Single element matches never overlap, so any-of and predicate scans have no mode
+template <typename TextSrc, typename NeedleSrc>
+    requires CanBeDelimiterOf<NeedleSrc, TextSrc>
+auto matches_any(const TextSrc& t, const NeedleSrc& d, Index start = Start, Index end = End, Index step = Step,
+                 Case sensitivity = Case::Sensitive)
+{
+    using E = container_type_t<TextSrc>;
+    using Matcher = detail::AnyMatcher<E, NeedleSrc>;
+    Text text(t);
+    return MatchView<E, Matcher>(detail::MatchScanner<E, Matcher>(text.ptr, text.length, Matcher(d, sensitivity),
+                                                                  MatchMode::Overlapping, start, end, step));
+}
+
+template <typename TextSrc, typename Predicate>
+auto matches_if(const TextSrc& t, Predicate pred, Index start = Start, Index end = End, Index step = Step)
+{
+    using E = container_type_t<TextSrc>;
+    using Matcher = detail::PredicateMatcher<E, Predicate>;
+    Text text(t);
+    return MatchView<E, Matcher>(detail::MatchScanner<E, Matcher>(text.ptr, text.length, Matcher{std::move(pred)},
+                                                                  MatchMode::Overlapping, start, end, step));
+}
+
+// Writes positions of all matches into out, a reused container may be filled with std::back_inserter
+template <typename TextSrc, typename NeedleSrc, typename OutputIt>
+    requires CanBeDelimiterOf<NeedleSrc, TextSrc>
+OutputIt find_all_into(const TextSrc& t, const NeedleSrc& n, OutputIt out, MatchMode mode = MatchMode::Overlapping,
+                       Index start = Start, Index end = End, Index step = Step, Case sensitivity = Case::Sensitive)
+{
+    using E = container_type_t<TextSrc>;
+    using Matcher = detail::NeedleMatcher<E, NeedleSrc>;
+    Text text(t);
+    return detail::find_all_into(
+        detail::MatchScanner<E, Matcher>(text.ptr, text.length, Matcher(n, sensitivity), mode, start, end, step),
+        out);
+}
+
+template <typename TextSrc, typename NeedleSrc, typename OutputIt>
+    requires CanBeDelimiterOf<NeedleSrc, TextSrc>
+OutputIt find_all_any_into(const TextSrc& t, const NeedleSrc& d, OutputIt out, Index start = Start, Index end = End,
+                           Index step = Step, Case sensitivity = Case::Sensitive)
+{
+    using E = container_type_t<TextSrc>;
+    using Matcher = detail::AnyMatcher<E, NeedleSrc>;
+    Text text(t);
+    return detail::find_all_into(detail::MatchScanner<E, Matcher>(text.ptr, text.length, Matcher(d, sensitivity),
+                                                                  MatchMode::Overlapping, start, end, step),
+                                 out);
+}
+
+template <typename TextSrc, typename Predicate, typename OutputIt>
+OutputIt find_all_if_into(const TextSrc& t, Predicate pred, OutputIt out, Index start = Start, Index end = End,
+                          Index step = Step)
+{
+    using E = container_type_t<TextSrc>;
+    using Matcher = detail::PredicateMatcher<E, Predicate>;
+    Text text(t);
+    return detail::find_all_into(detail::MatchScanner<E, Matcher>(text.ptr, text.length, Matcher{std::move(pred)},
+                                                                  MatchMode::Overlapping, start, end, step),
+                                 out);
+}
+
+template <typename TextSrc, typename NeedleSrc>
+    requires CanBeDelimiterOf<NeedleSrc, TextSrc>
+std::vector<Index> find_all(const TextSrc& t, const NeedleSrc& n, MatchMode mode = MatchMode::Overlapping,
+                            Index start = Start, Index end = End, Index step = Step,
+                            Case sensitivity = Case::Sensitive)
+{
+    std::vector<Index> positions;
+    find_all_into(t, n, std::back_inserter(positions), mode, start, end, step, sensitivity);
+    return positions;
+}
+
+template <typename TextSrc, typename NeedleSrc>
+    requires CanBeDelimiterOf<NeedleSrc, TextSrc>
+std::vector<Index> find_all_any(const TextSrc& t, const NeedleSrc& d, Index start = Start, Index end = End,
+                                Index step = Step, Case sensitivity = Case::Sensitive)
+{
+    std::vector<Index> positions;
+    find_all_any_into(t, d, std::back_inserter(positions), start, end, step, sensitivity);
+    return positions;
+}
+
+template <typename TextSrc, typename Predicate>
+std::vector<Index> find_all_if(const TextSrc& t, Predicate pred, Index start = Start, Index end = End,
+                               Index step = Step)
+{
+    std::vector<Index> positions;
+    find_all_if_into(t, std::move(pred), std::back_inserter(positions), start, end, step);
+    return positions;
+}
+
+} // namespace Text
@@ -1,33 +1,105 @@
 #pragma once
 
 #include "common.hpp"
+#include "sub.hpp"
+
+#include <cstring>
+#include <iterator>
+#include <ranges>
+
+namespace detail {
+
+template <typename E>
+void copy_elements(E* dest, const E* src, size_t count)
+{
+    if constexpr (std::is_trivially_copyable_v<E>)
+    {
+        if (count != 0)
+            std::memcpy(dest, src, count * sizeof(E));
+    }
+    else
+        std::copy_n(src, count, dest);
+}
+
+// Joined texts are copied in one piece, strided views element by element
+template <typename E, typename Item>
+size_t joined_length(const Item& item)
+{
+    if constexpr (is_strided_view<Item>::value)
+        return item.size();
+    else
+        return Text::Text<E>(item).length;
+}
+
+template <typename E, typename Item>
+E* copy_joined(E* dest, const Item& item)
+{
+    if constexpr (is_strided_view<Item>::value)
+        return std::ranges::copy(item, dest).out;
+    else
+    {
+        Text::Text<E> text(item);
+        copy_elements(dest, text.ptr, text.length);
+        return dest + text.length;
+    }
+}
+
+} // namespace detail
 
 namespace Text {
-template <typename TextSrc, typename DelimSrc>
-    requires CanBeDelimiterOf<DelimSrc, TextSrc>
-auto join(const std::vector<TextSrc>& views, DelimSrc d)
+
+// Element type of texts in a range accepted by join
+template <typename R>
+using joined_type_t = container_type_t<std::ranges::range_value_t<R>>;
+
+// Appends joined texts to out, which grows once to the final size. Views may be any forward range of texts
+// (vector, span, lazy split results, strided views, ...), it is traversed twice.
+template <typename E, typename StringAlloc, std::ranges::forward_range R, typename DelimSrc>
+    requires std::same_as<joined_type_t<R>, E> && CanBeDelimiterOf<DelimSrc, std::ranges::range_value_t<R>>
+std::basic_string<E, std::char_traits<E>, StringAlloc>& join_into(
+    std::basic_string<E, std::char_traits<E>, StringAlloc>& out, R&& views, DelimSrc d)
 {
-    std::basic_string<container_type_t<TextSrc>> result;
-    if (views.empty())
-        return result;
+    auto first = std::ranges::begin(views);
+    const auto last = std::ranges::end(views);
+    if (first == last)
+        return out;
 
     Delimiter delimiter(d);
-    auto size = delimiter.length * (views.size() - 1);
-    for (const auto& item : views)
-        size += item.length();
-
-    result.resize(size);
-    auto ptr = result.data();
-    auto end = result.data() + result.length();
-    for (const auto& item : views)
+    size_t size = 0;
+    size_t count = 0;
+    for (auto it = first; it != last; ++it, ++count)
+        size += detail::joined_length<E>(*it);
+    size += delimiter.length * (count - 1);
+
+    const auto offset = out.size();
+    out.resize(offset + size);
+    auto* ptr = out.data() + offset;
+    for (auto it = first; it != last; ++it)
     {
-        strncpy(ptr, item.data(), item.length());
-        ptr += item.length();
-        if (ptr == end)
-            break;
-        strncpy(ptr, delimiter.ptr, delimiter.length);
-        ptr += delimiter.length;
+        if (it != first)
+        {
+            detail::copy_elements(ptr, delimiter.ptr, delimiter.length);
+            ptr += delimiter.length;
+        }
+        ptr = detail::copy_joined<E>(ptr, *it);
     }
+    return out;
+}
+
+// Result string is built with given allocator (rebound to element type)
+template <typename Alloc, std::ranges::forward_range R, typename DelimSrc>
+    requires CanBeDelimiterOf<DelimSrc, std::ranges::range_value_t<R>>
+auto join(std::allocator_arg_t, const Alloc& alloc, R&& views, DelimSrc d)
+{
+    detail::AllocString<joined_type_t<R>, Alloc> result(alloc);
+    join_into(result, std::forward<R>(views), d);
     return result;
 }
-} // namespace Text
\ No newline at end of file
+
+template <std::ranges::forward_range R, typename DelimSrc>
+    requires CanBeDelimiterOf<DelimSrc, std::ranges::range_value_t<R>>
+auto join(R&& views, DelimSrc d)
+{
+    return join(std::allocator_arg, std::allocator<joined_type_t<R>>(), std::forward<R>(views), d);
+}
+} // namespace Text
@@ -0,0 +1,250 @@
+#pragma once
+
+#include "common.hpp"
+#include "join.hpp"
+
+#include <cerrno>
+#include <concepts>
+#include <ostream>
+#include <ranges>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+namespace detail {
+
+template <typename E>
+struct OstreamSink
+{
+    std::basic_ostream<E>* stream;
+
+    void operator()(std::basic_string_view<E> data)
+    {
+        stream->write(data.data(), static_cast<std::streamsize>(data.size()));
+    }
+};
+
+// Writes whole pieces retrying partial writes, a buffer followed by a large piece goes out in one writev call.
+// A call writing nothing for a non-empty request fails with EIO instead of being retried forever. System calls
+// are template parameters, so they can be replaced in tests.
+#if defined(_WIN32)
+template <auto Write = ::_write>
+#else
+template <auto Write = ::write, auto Writev = ::writev>
+#endif
+struct BasicFdSink
+{
+    int fd;
+
+    void operator()(std::string_view data)
+    {
+        while (!data.empty())
+            data.remove_prefix(write_some(data.data(), data.size()));
+    }
+
+    void operator()(std::string_view first, std::string_view second)
+    {
+#if defined(_WIN32)
+        (*this)(first);
+        (*this)(second);
+#else
+        while (!first.empty())
+        {
+            iovec pieces[2] = {{const_cast<char*>(first.data()), first.size()},
+                               {const_cast<char*>(second.data()), second.size()}};
+            const auto written = Writev(fd, pieces, 2);
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                throw std::system_error(errno, std::generic_category(), "writev");
+            }
+            if (written == 0)
+                throw std::system_error(EIO, std::generic_category(), "writev");
+            const auto from_first = std::min(first.size(), static_cast<size_t>(written));
+            first.remove_prefix(from_first);
+            second.remove_prefix(static_cast<size_t>(written) - from_first);
+        }
+        (*this)(second);
+#endif
+    }
+
+private:
+    size_t write_some(const char* data, size_t size)
+    {
+        for (;;)
+        {
+#if defined(_WIN32)
+            const auto written = Write(fd, data, static_cast<unsigned>(std::min<size_t>(size, 1u << 30)));
+#else
+            const auto written = Write(fd, data, size);
+#endif
+            if (written > 0)
+                return static_cast<size_t>(written);
+            if (written == 0)
+                throw std::system_error(EIO, std::generic_category(), "write");
+            if (errno != EINTR)
+                throw std::system_error(errno, std::generic_category(), "write");
+        }
+    }
+};
+
+using FdSink = BasicFdSink<>;
+
+} // namespace detail
+
+namespace Text {
+
+// Default number of elements buffered before they are written out
+constexpr size_t JoinBufferSize = size_t{64} << 10;
+
+// Sink receives written data as views valid for the duration of a call. It may also take two views written
+// one after another (buffered data and a large piece), to send them without copying the piece.
+template <typename S, typename E>
+concept JoinSink = std::invocable<S&, std::basic_string_view<E>>;
+
+// Joins texts added one by one the same way as join (delimiter between texts, not before the first one) and
+// writes the result through a fixed buffer, so memory use does not depend on output size. Pieces not shorter
+// than the buffer bypass it. restart starts a new join, write adds a text without a delimiter, e.g. to end
+// a line of fields. Destructor flushes remaining data ignoring errors, call flush to get them reported.
+template <typename E, JoinSink<E> Sink>
+class JoinWriter
+{
+public:
+    template <typename DelimSrc>
+        requires std::same_as<container_type_t<DelimSrc>, E>
+    JoinWriter(Sink sink, const DelimSrc& d, size_t buffer_size = JoinBufferSize)
+        : sink_(std::move(sink))
+        , buffer_(std::max<size_t>(buffer_size, 1))
+    {
+        Delimiter delimiter(d);
+        delimiter_.assign(delimiter.ptr, delimiter.length);
+    }
+
+    JoinWriter(const JoinWriter&) = delete;
+    JoinWriter& operator=(const JoinWriter&) = delete;
+
+    ~JoinWriter()
+    {
+        try
+        {
+            flush();
+        }
+        catch (...)
+        {
+        }
+    }
+
+    // Adds a text (or single element) preceded by a delimiter unless it is the first one since restart
+    template <typename TextSrc>
+        requires std::same_as<container_type_t<TextSrc>, E>
+    JoinWriter& add(const TextSrc& item)
+    {
+        if (!first_)
+            put(delimiter_);
+        first_ = false;
+        Delimiter<E> text(item);
+        put({text.ptr, text.length});
+        return *this;
+    }
+
+    template <std::ranges::input_range R>
+        requires std::same_as<joined_type_t<R>, E>
+    JoinWriter& add_range(R&& items)
+    {
+        for (const auto& item : items)
+            add(item);
+        return *this;
+    }
+
+    // Writes a text as it is, without a delimiter
+    template <typename TextSrc>
+        requires std::same_as<container_type_t<TextSrc>, E>
+    JoinWriter& write(const TextSrc& data)
+    {
+        Delimiter<E> text(data);
+        put({text.ptr, text.length});
+        return *this;
+    }
+
+    // Next added text is not preceded by a delimiter
+    JoinWriter& restart()
+    {
+        first_ = true;
+        return *this;
+    }
+
+    // Writes buffered data out
+    void flush()
+    {
+        if (filled_ == 0)
+            return;
+        const auto filled = std::exchange(filled_, 0);
+        sink_(std::basic_string_view<E>(buffer_.data(), filled));
+    }
+
+private:
+    void put(std::basic_string_view<E> piece)
+    {
+        if (piece.size() >= buffer_.size())
+        {
+            const std::basic_string_view<E> buffered(buffer_.data(), std::exchange(filled_, 0));
+            if constexpr (std::invocable<Sink&, std::basic_string_view<E>, std::basic_string_view<E>>)
+                sink_(buffered, piece);
+            else
+            {
+                if (!buffered.empty())
+                    sink_(buffered);
+                sink_(piece);
+            }
+            return;
+        }
+        // Buffer is filled up before it is written, so the sink gets pieces of buffer size
+        while (!piece.empty())
+        {
+            const auto count = std::min(piece.size(), buffer_.size() - filled_);
+            detail::copy_elements(buffer_.data() + filled_, piece.data(), count);
+            filled_ += count;
+            piece.remove_prefix(count);
+            if (filled_ == buffer_.size())
+                flush();
+        }
+    }
+
+    Sink sink_;
+    std::basic_string<E> delimiter_;
+    std::vector<E> buffer_;
+    size_t filled_ = 0;
+    bool first_ = true;
+};
+
+template <typename E, typename DelimSrc>
+    requires std::same_as<container_type_t<DelimSrc>, E>
+auto join_writer(std::basic_ostream<E>& output, const DelimSrc& d, size_t buffer_size = JoinBufferSize)
+{
+    return JoinWriter<E, detail::OstreamSink<E>>(detail::OstreamSink<E>{&output}, d, buffer_size);
+}
+
+// File descriptor is not closed, write errors throw std::system_error
+template <typename DelimSrc>
+    requires std::same_as<container_type_t<DelimSrc>, char>
+auto join_writer(int fd, const DelimSrc& d, size_t buffer_size = JoinBufferSize)
+{
+    return JoinWriter<char, detail::FdSink>(detail::FdSink{fd}, d, buffer_size);
+}
+
+template <typename Sink, typename DelimSrc, typename E = container_type_t<DelimSrc>>
+    requires JoinSink<Sink, E>
+auto join_writer(Sink sink, const DelimSrc& d, size_t buffer_size = JoinBufferSize)
+{
+    return JoinWriter<E, Sink>(std::move(sink), d, buffer_size);
+}
+
+} // namespace Text
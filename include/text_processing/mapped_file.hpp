@@ -0,0 +1,211 @@
+#pragma once
+
+#include "common.hpp"
+
+#include <filesystem>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Text {
+
+// How mapped contents are going to be read, passed to the OS as a read-ahead hint
+enum class AccessHint
+{
+    Normal,
+    Sequential,
+    Random,
+};
+
+// Read-only memory mapping of a file usable as a text source (data/size/value_type), so every operation works
+// on file contents without copying them. Views and positions stay valid while the mapping lives. Trailing
+// bytes not forming a whole element are not part of the text. Errors are reported with std::system_error.
+template <typename E>
+class BasicMappedFile
+{
+public:
+    using value_type = E;
+
+    BasicMappedFile() = default;
+
+    explicit BasicMappedFile(const std::filesystem::path& path, AccessHint hint = AccessHint::Sequential)
+    {
+        map(path, hint);
+    }
+
+    BasicMappedFile(const BasicMappedFile&) = delete;
+    BasicMappedFile& operator=(const BasicMappedFile&) = delete;
+
+    BasicMappedFile(BasicMappedFile&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr))
+        , bytes_(std::exchange(other.bytes_, 0))
+    {}
+
+    BasicMappedFile& operator=(BasicMappedFile&& other) noexcept
+    {
+        if (this != &other)
+        {
+            unmap();
+            data_ = std::exchange(other.data_, nullptr);
+            bytes_ = std::exchange(other.bytes_, 0);
+        }
+        return *this;
+    }
+
+    ~BasicMappedFile()
+    {
+        unmap();
+    }
+
+    const E* data() const
+    {
+        return static_cast<const E*>(data_);
+    }
+
+    size_t size() const
+    {
+        return bytes_ / sizeof(E);
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    const E* begin() const
+    {
+        return data();
+    }
+
+    const E* end() const
+    {
+        return data() + size();
+    }
+
+    std::basic_string_view<E> view() const
+    {
+        return {data(), size()};
+    }
+
+private:
+#if defined(_WIN32)
+    void map(const std::filesystem::path& path, AccessHint hint)
+    {
+        DWORD flags = FILE_ATTRIBUTE_NORMAL;
+        if (hint == AccessHint::Sequential)
+            flags |= FILE_FLAG_SEQUENTIAL_SCAN;
+        else if (hint == AccessHint::Random)
+            flags |= FILE_FLAG_RANDOM_ACCESS;
+        HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, flags, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            throw std::system_error(static_cast<int>(GetLastError()), std::system_category(), path.string());
+
+        LARGE_INTEGER file_size{};
+        if (!GetFileSizeEx(file, &file_size))
+        {
+            const auto error = GetLastError();
+            CloseHandle(file);
+            throw std::system_error(static_cast<int>(error), std::system_category(), path.string());
+        }
+        // Empty files can not be mapped, they are represented by an empty text
+        if (file_size.QuadPart == 0)
+        {
+            CloseHandle(file);
+            return;
+        }
+
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        const auto mapping_error = GetLastError();
+        CloseHandle(file);
+        if (mapping == nullptr)
+            throw std::system_error(static_cast<int>(mapping_error), std::system_category(), path.string());
+        // View keeps the mapping object alive
+        data_ = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        const auto view_error = GetLastError();
+        CloseHandle(mapping);
+        if (data_ == nullptr)
+            throw std::system_error(static_cast<int>(view_error), std::system_category(), path.string());
+        bytes_ = static_cast<size_t>(file_size.QuadPart);
+    }
+
+    void unmap() noexcept
+    {
+        if (data_ != nullptr)
+            UnmapViewOfFile(data_);
+        data_ = nullptr;
+        bytes_ = 0;
+    }
+#else
+    void map(const std::filesystem::path& path, AccessHint hint)
+    {
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+            throw std::system_error(errno, std::generic_category(), path.string());
+
+        struct stat info{};
+        if (::fstat(fd, &info) != 0)
+        {
+            const int error = errno;
+            ::close(fd);
+            throw std::system_error(error, std::generic_category(), path.string());
+        }
+        // Empty files can not be mapped, they are represented by an empty text
+        if (info.st_size == 0)
+        {
+            ::close(fd);
+            return;
+        }
+
+        const auto bytes = static_cast<size_t>(info.st_size);
+        void* mapped = ::mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+        const int error = errno;
+        // Mapping stays valid after its descriptor is closed
+        ::close(fd);
+        if (mapped == MAP_FAILED)
+            throw std::system_error(error, std::generic_category(), path.string());
+        data_ = mapped;
+        bytes_ = bytes;
+
+        // Hints only, failures are not errors
+        if (hint == AccessHint::Sequential)
+            ::madvise(mapped, bytes, MADV_SEQUENTIAL);
+        else if (hint == AccessHint::Random)
+            ::madvise(mapped, bytes, MADV_RANDOM);
+#if defined(MADV_HUGEPAGE)
+        constexpr size_t huge_page_size = size_t{2} << 20;
+        if (bytes >= huge_page_size)
+            ::madvise(mapped, bytes, MADV_HUGEPAGE);
+#endif
+    }
+
+    void unmap() noexcept
+    {
+        if (data_ != nullptr)
+            ::munmap(data_, bytes_);
+        data_ = nullptr;
+        bytes_ = 0;
+    }
+#endif
+
+    void* data_ = nullptr;
+    size_t bytes_ = 0;
+};
+
+using MappedFile = BasicMappedFile<char>;
+
+} // namespace Text
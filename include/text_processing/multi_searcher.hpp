@@ -0,0 +1,393 @@
+#pragma once
+
+#include "common.hpp"
+#include "split.hpp"
+
+#include <initializer_list>
+#include <queue>
+#include <ranges>
+#include <variant>
+
+namespace Text {
+
+// Match reported by multi-needle search. Position is End when nothing was found.
+struct MultiMatch
+{
+    Index position = End;
+    // Index of matched needle in the list searcher was built from
+    size_t needle = 0;
+    size_t length = 0;
+
+    bool found() const
+    {
+        return position != End;
+    }
+
+    bool operator==(const MultiMatch&) const = default;
+};
+
+// Set of needles searched in a single pass over a text (Aho-Corasick automaton). Overlapping needles are resolved
+// leftmost-longest: match starting first wins, from those starting at the same position the longest one.
+// Empty needles never match. Case sensitivity is fixed at construction.
+template <typename E>
+class MultiSearcher
+{
+public:
+    using value_type = E;
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+    template <std::ranges::range Needles>
+    explicit MultiSearcher(const Needles& needles, Case case_sensitivity = Case::Sensitive)
+        : sensitivity_(case_sensitivity)
+    {
+        for (const auto& needle : needles)
+            add(Delimiter(needle));
+        build();
+    }
+    explicit MultiSearcher(std::initializer_list<std::basic_string_view<E>> needles,
+                           Case case_sensitivity = Case::Sensitive)
+        : sensitivity_(case_sensitivity)
+    {
+        for (const auto& needle : needles)
+            add(Delimiter(needle));
+        build();
+    }
+
+    // Number of needles, including empty and repeated ones
+    size_t size() const
+    {
+        return lengths_.size();
+    }
+
+    size_t needle_length(size_t needle) const
+    {
+        return lengths_[needle];
+    }
+
+    Case sensitivity() const
+    {
+        return sensitivity_;
+    }
+
+    // Returns leftmost-longest match in [first, last) as pointer to its start (or last) and needle index
+    std::pair<const E*, size_t> find_in(const E* first, const E* last) const
+    {
+        const E* best = last;
+        size_t best_needle = npos;
+        uint32_t state = 0;
+        for (const auto* current = first; current < last; ++current)
+        {
+            state = next_state(state, *current);
+            // Every match found later starts after the part of text current state stands for
+            if (best != last && current + 1 - depths_[state] > best)
+                break;
+            const auto needle = outputs_[state];
+            if (needle == npos)
+                continue;
+            const auto* start = current + 1 - lengths_[needle];
+            if (best == last || start < best || (start == best && lengths_[needle] > lengths_[best_needle]))
+            {
+                best = start;
+                best_needle = needle;
+            }
+        }
+        return {best, best_needle};
+    }
+
+    // Calls callback(start, needle) for every occurrence of every needle in [first, last), overlapping ones too,
+    // in order of match end. Repeated needles are reported once, with index of the first one.
+    template <typename Callback>
+    void for_each_in(const E* first, const E* last, Callback callback) const
+    {
+        uint32_t state = 0;
+        for (const auto* current = first; current < last; ++current)
+        {
+            state = next_state(state, *current);
+            for (auto match = terminals_[state] != npos ? state : dictionary_[state]; match != 0;
+                 match = dictionary_[match])
+            {
+                const auto needle = terminals_[match];
+                callback(current + 1 - lengths_[needle], needle);
+            }
+        }
+    }
+
+    // Index of the first needle equal to given one, used to report repeated needles
+    size_t canonical(size_t needle) const
+    {
+        return canonical_[needle];
+    }
+
+private:
+    static constexpr uint32_t none = std::numeric_limits<uint32_t>::max();
+
+    E fold(E elem) const
+    {
+        return sensitivity_ == Case::Sensitive ? elem : detail::caseless(elem);
+    }
+
+    void add(const Delimiter<E>& needle)
+    {
+        lengths_.push_back(needle.length);
+        needles_.emplace_back(needle.ptr, needle.ptr + needle.length);
+        for (auto& elem : needles_.back())
+            elem = fold(elem);
+    }
+
+    uint32_t alphabet_index(E elem) const
+    {
+        if constexpr (detail::ByteChar<E>)
+            return byte_classes_[static_cast<uint8_t>(elem)];
+        else
+        {
+            const auto folded = fold(elem);
+            const auto it = std::lower_bound(alphabet_.begin(), alphabet_.end(), folded);
+            return it != alphabet_.end() && *it == folded ? static_cast<uint32_t>(it - alphabet_.begin()) + 1 : 0;
+        }
+    }
+
+    uint32_t next_state(uint32_t state, E elem) const
+    {
+        return transitions_[state * classes_ + alphabet_index(elem)];
+    }
+
+    uint32_t add_state(size_t depth)
+    {
+        transitions_.resize(transitions_.size() + classes_, none);
+        depths_.push_back(depth);
+        terminals_.push_back(npos);
+        return static_cast<uint32_t>(depths_.size() - 1);
+    }
+
+    void build()
+    {
+        // Elements which do not occur in any needle share class 0
+        std::vector<E> elements;
+        for (const auto& needle : needles_)
+            elements.insert(elements.end(), needle.begin(), needle.end());
+        std::sort(elements.begin(), elements.end());
+        elements.erase(std::unique(elements.begin(), elements.end()), elements.end());
+        classes_ = elements.size() + 1;
+        if constexpr (detail::ByteChar<E>)
+        {
+            for (size_t idx = 0; idx < elements.size(); ++idx)
+                byte_classes_[static_cast<uint8_t>(elements[idx])] = static_cast<uint32_t>(idx + 1);
+            if (sensitivity_ == Case::Insensitive)
+                for (size_t byte = 0; byte < byte_classes_.size(); ++byte)
+                    byte_classes_[byte] = byte_classes_[static_cast<uint8_t>(fold(static_cast<E>(byte)))];
+        }
+        else
+            alphabet_ = std::move(elements);
+
+        // Trie of needles
+        add_state(0);
+        canonical_.resize(needles_.size());
+        for (size_t needle = 0; needle < needles_.size(); ++needle)
+        {
+            canonical_[needle] = needle;
+            if (needles_[needle].empty())
+                continue;
+            uint32_t state = 0;
+            for (const auto elem : needles_[needle])
+            {
+                const auto transition = state * classes_ + alphabet_index(elem);
+                if (transitions_[transition] == none)
+                {
+                    // Slot is addressed by index, adding a state reallocates the table
+                    const auto created = add_state(depths_[state] + 1);
+                    transitions_[transition] = created;
+                }
+                state = transitions_[transition];
+            }
+            if (terminals_[state] == npos)
+                terminals_[state] = needle;
+            else
+                canonical_[needle] = terminals_[state];
+        }
+        needles_.clear();
+        needles_.shrink_to_fit();
+
+        // Failure links turned into a complete transition table, breadth first so shorter states are done first
+        const auto states = depths_.size();
+        std::vector<uint32_t> failure(states, 0);
+        outputs_.assign(states, npos);
+        dictionary_.assign(states, 0);
+        std::queue<uint32_t> pending;
+        for (size_t cls = 0; cls < classes_; ++cls)
+        {
+            auto& target = transitions_[cls];
+            if (target == none)
+                target = 0;
+            else
+                pending.push(target);
+        }
+        while (!pending.empty())
+        {
+            const auto state = pending.front();
+            pending.pop();
+            const auto fail = failure[state];
+            outputs_[state] = terminals_[state] != npos ? terminals_[state] : outputs_[fail];
+            dictionary_[state] = terminals_[fail] != npos ? fail : dictionary_[fail];
+            for (size_t cls = 0; cls < classes_; ++cls)
+            {
+                auto& target = transitions_[state * classes_ + cls];
+                if (target == none)
+                    target = transitions_[fail * classes_ + cls];
+                else
+                {
+                    failure[target] = transitions_[fail * classes_ + cls];
+                    pending.push(target);
+                }
+            }
+        }
+    }
+
+    Case sensitivity_ = Case::Sensitive;
+    std::vector<std::vector<E>> needles_;
+    std::vector<size_t> lengths_;
+    std::vector<size_t> canonical_;
+    std::conditional_t<detail::ByteChar<E>, std::array<uint32_t, 256>, std::monostate> byte_classes_{};
+    std::vector<E> alphabet_;
+    size_t classes_ = 1;
+    // Complete transition table, classes_ entries per state
+    std::vector<uint32_t> transitions_;
+    std::vector<size_t> depths_;
+    // Needle ending exactly in a state
+    std::vector<size_t> terminals_;
+    // Longest needle which is a suffix of a state
+    std::vector<size_t> outputs_;
+    // Next shorter suffix state which is a terminal (0 when there is none)
+    std::vector<uint32_t> dictionary_;
+};
+
+template <std::ranges::range Needles>
+MultiSearcher(const Needles& needles, Case c = Case::Sensitive)
+    -> MultiSearcher<container_type_t<std::ranges::range_value_t<Needles>>>;
+
+} // namespace Text
+
+namespace detail {
+
+template <typename T>
+struct is_multi_searcher : std::false_type
+{};
+template <typename E>
+struct is_multi_searcher<Text::MultiSearcher<E>> : std::true_type
+{};
+
+// Either a Text::MultiSearcher or a range of (non single element) needles of the same type as a text
+template <typename Needles, typename TextSrc>
+concept NeedlesOf = (is_multi_searcher<Needles>::value && SameDataType<Needles, TextSrc>) ||
+                    (std::ranges::range<Needles> && CanBeDelimiterOf<std::ranges::range_value_t<Needles>, TextSrc> &&
+                     !std::same_as<std::ranges::range_value_t<Needles>, container_type_t<TextSrc>>);
+
+// Returns reference to already built searcher or builds one from needles
+template <typename E, typename Needles>
+decltype(auto) multi_searcher_of(const Needles& needles, Text::Case sensitivity)
+{
+    if constexpr (is_multi_searcher<Needles>::value)
+        return (needles);
+    else
+        return Text::MultiSearcher<E>(needles, sensitivity);
+}
+
+template <typename E, typename Needles>
+struct MultiMatcher
+{
+    using Storage = std::conditional_t<is_multi_searcher<Needles>::value, const Needles*, Text::MultiSearcher<E>>;
+
+    Storage searcher;
+    size_t length = 1;
+
+    MultiMatcher(const Needles& needles, Text::Case sensitivity)
+        : searcher(init(needles, sensitivity))
+    {}
+
+    static Storage init(const Needles& needles, Text::Case sensitivity)
+    {
+        if constexpr (is_multi_searcher<Needles>::value)
+            return &needles;
+        else
+            return Text::MultiSearcher<E>(needles, sensitivity);
+    }
+
+    const Text::MultiSearcher<E>& get() const
+    {
+        if constexpr (is_multi_searcher<Needles>::value)
+            return *searcher;
+        else
+            return searcher;
+    }
+
+    size_t size() const
+    {
+        return length;
+    }
+
+    // Only unit step is used for multi-needle split
+    const E* next(const E* current, const E* last, Text::Index)
+    {
+        const auto [found, needle] = get().find_in(current, last);
+        if (found == last)
+            return nullptr;
+        length = get().needle_length(needle);
+        return found;
+    }
+};
+
+} // namespace detail
+
+namespace Text {
+
+// Leftmost-longest occurrence of any of needles in [start, end)
+template <typename TextSrc, typename Needles>
+    requires detail::NeedlesOf<Needles, TextSrc>
+MultiMatch find_first_of_words(const TextSrc& t, const Needles& needles, Index start = Start, Index end = End,
+                               Case sensitivity = Case::Sensitive)
+{
+    using E = container_type_t<TextSrc>;
+    Text text(t);
+    if (sanitize_index(start, text.length) == End || sanitize_index(end, text.length) == End)
+        return {};
+
+    const auto& searcher = detail::multi_searcher_of<E>(needles, sensitivity);
+    const auto [found, needle] = searcher.find_in(text.ptr + start, text.ptr + end);
+    if (found == text.ptr + end)
+        return {};
+    return {static_cast<Index>(found - text.ptr), needle, searcher.needle_length(needle)};
+}
+
+// Number of (possibly overlapping) occurrences of every needle in [start, end), in order of needles
+template <typename TextSrc, typename Needles>
+    requires detail::NeedlesOf<Needles, TextSrc>
+std::vector<Index> count_each(const TextSrc& t, const Needles& needles, Index start = Start, Index end = End,
+                              Case sensitivity = Case::Sensitive)
+{
+    using E = container_type_t<TextSrc>;
+    Text text(t);
+    const auto& searcher = detail::multi_searcher_of<E>(needles, sensitivity);
+    std::vector<Index> counts(searcher.size(), 0);
+    if (sanitize_index(start, text.length) == End || sanitize_index(end, text.length) == End)
+        return counts;
+
+    searcher.for_each_in(text.ptr + start, text.ptr + end, [&](const E*, size_t needle) { ++counts[needle]; });
+    for (size_t needle = 0; needle < counts.size(); ++needle)
+        counts[needle] = counts[searcher.canonical(needle)];
+    return counts;
+}
+
+// Split by non-overlapping leftmost-longest occurrences of needles. Text outside [start, end) is part of first/last
+// fragment like in split.
+template <typename TextSrc, typename Needles>
+    requires detail::NeedlesOf<Needles, TextSrc>
+auto split_multi(const TextSrc& t, const Needles& needles, SplitBehavior beh = SplitBehavior::KeepEmpty,
+                 Index start = Start, Index end = End, Case sensitivity = Case::Sensitive)
+{
+    using E = container_type_t<TextSrc>;
+    using Matcher = detail::MultiMatcher<E, Needles>;
+    Text text(t);
+    return detail::split_all(
+        detail::Splitter<E, Matcher>(text.ptr, text.length, Matcher(needles, sensitivity), beh, start, end, Step));
+}
+
+} // namespace Text
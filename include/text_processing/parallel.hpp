@@ -0,0 +1,186 @@
+#pragma once
+
+#include "common.hpp"
+#include "count.hpp"
+#include "executor.hpp"
+#include "find_all.hpp"
+
+#include <atomic>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace detail {
+
+// Lattice positions scanned by a single task, small enough for a found match to cancel most of the remaining work
+constexpr size_t parallel_block = size_t{1} << 16;
+
+// Positions a match of given length may start at, listed in scan order (descending for a negative step)
+struct MatchLattice
+{
+    Text::Index first = 0;
+    Text::Index step = 1;
+    size_t positions = 0;
+    size_t match_length = 0;
+
+    // Position of index-th element in scan order
+    Text::Index at(size_t index) const
+    {
+        return first + static_cast<Text::Index>(index) * step;
+    }
+
+    // Range [start, end) of text holding matches starting at positions [from, to) of scan order
+    std::pair<Text::Index, Text::Index> range(size_t from, size_t to) const
+    {
+        const auto low = step > 0 ? at(from) : at(to - 1);
+        const auto high = step > 0 ? at(to - 1) : at(from);
+        return {low, high + static_cast<Text::Index>(match_length)};
+    }
+};
+
+inline std::optional<MatchLattice> match_lattice(size_t length, size_t match_length, Text::Index start,
+                                                 Text::Index end, Text::Index step)
+{
+    if (step == 0 || match_length == 0)
+        return std::nullopt;
+    if (Text::sanitize_index(start, length) == Text::End || Text::sanitize_index(end, length) == Text::End)
+        return std::nullopt;
+    const auto len = static_cast<Text::Index>(match_length);
+    if (end - start < len)
+        return std::nullopt;
+    const auto distance = step > 0 ? step : -step;
+    const auto positions = static_cast<size_t>((end - len - start) / distance + 1);
+    return MatchLattice{step > 0 ? start : end - len, step, positions, match_length};
+}
+
+// Like find_impl, a search with a negative step goes down to the beginning of the text, start only has to be valid
+inline Text::Index find_start(Text::Index start, size_t length, Text::Index step)
+{
+    if (step < 0 && Text::sanitize_index(std::as_const(start), length) != Text::End)
+        return Text::Start;
+    return start;
+}
+
+// Matches are counted on |step| lattice of every chunk, which for a negative step is anchored at its lowest point
+template <Text::Executor Executor, typename CountChunk>
+Text::Index parallel_count(Executor& executor, const MatchLattice& lattice, CountChunk count_chunk)
+{
+    const auto tasks = std::min(executor.concurrency(), (lattice.positions + parallel_block - 1) / parallel_block);
+    if (tasks <= 1)
+    {
+        const auto [low, high] = lattice.range(0, lattice.positions);
+        return count_chunk(low, high, lattice.step > 0 ? lattice.step : -lattice.step);
+    }
+    std::vector<Text::Index> counts(tasks);
+    executor.bulk(tasks, [&](size_t task) {
+        const auto [low, high] =
+            lattice.range(lattice.positions * task / tasks, lattice.positions * (task + 1) / tasks);
+        counts[task] = count_chunk(low, high, lattice.step > 0 ? lattice.step : -lattice.step);
+    });
+    Text::Index total = 0;
+    for (auto count : counts)
+        total += count;
+    return total;
+}
+
+// Blocks are taken in scan order, once a block has a match the blocks after it are not scanned anymore
+template <Text::Executor Executor, typename E, typename Matcher>
+Text::Index parallel_find(Executor& executor, const E* ptr, size_t length, const Matcher& matcher,
+                          const MatchLattice& lattice)
+{
+    const auto tasks = (lattice.positions + parallel_block - 1) / parallel_block;
+    auto find_in_block = [&](size_t task) {
+        const auto [low, high] =
+            lattice.range(task * parallel_block, std::min(lattice.positions, (task + 1) * parallel_block));
+        MatchScanner<E, Matcher> scanner(ptr, length, matcher, Text::MatchMode::Overlapping, low, high, lattice.step);
+        return scanner.begin().position;
+    };
+    if (tasks <= 1 || executor.concurrency() <= 1)
+    {
+        for (size_t task = 0; task < tasks; ++task)
+            if (auto found = find_in_block(task); found != Text::End)
+                return found;
+        return Text::End;
+    }
+
+    std::vector<Text::Index> found(tasks, Text::End);
+    std::atomic<size_t> first_found = tasks;
+    executor.bulk(tasks, [&](size_t task) {
+        if (task > first_found.load(std::memory_order_relaxed))
+            return;
+        found[task] = find_in_block(task);
+        if (found[task] == Text::End)
+            return;
+        auto current = first_found.load(std::memory_order_relaxed);
+        while (task < current && !first_found.compare_exchange_weak(current, task, std::memory_order_relaxed))
+            ;
+    });
+    return first_found < tasks ? found[first_found] : Text::End;
+}
+
+} // namespace detail
+
+namespace Text {
+
+// Overloads taking an executor (ThreadPool, SequentialExecutor or any type satisfying Executor) split the text
+// into chunks scanned concurrently. Results are the same as without an executor. count and count_any look for
+// matches within [start, end). Like find_impl, a find with a negative step searches backwards from end down to
+// the beginning of the text, start only has to be a valid index.
+template <Executor Exec, typename TextSrc, typename NeedleSrc>
+    requires CanBeDelimiterOf<NeedleSrc, TextSrc>
+Index count(Exec& executor, const TextSrc& t, const NeedleSrc& n, Index start = Start, Index end = End,
+            Index step = Step, Case sensitivity = Case::Sensitive)
+{
+    Text text(t);
+    const auto lattice = detail::match_lattice(text.length, Delimiter(n).length, start, end, step);
+    if (!lattice)
+        return 0;
+    return detail::parallel_count(executor, *lattice, [&](Index low, Index high, Index distance) {
+        return count(t, n, low, high, distance, sensitivity);
+    });
+}
+
+template <Executor Exec, typename TextSrc, typename NeedleSrc>
+    requires CanBeDelimiterOf<NeedleSrc, TextSrc>
+Index count_any(Exec& executor, const TextSrc& t, const NeedleSrc& d, Index start = Start, Index end = End,
+                Index step = Step, Case sensitivity = Case::Sensitive)
+{
+    Text text(t);
+    const auto lattice = detail::match_lattice(text.length, 1, start, end, step);
+    if (!lattice)
+        return 0;
+    return detail::parallel_count(executor, *lattice, [&](Index low, Index high, Index distance) {
+        return count_any(t, d, low, high, distance, sensitivity);
+    });
+}
+
+template <Executor Exec, typename TextSrc, typename NeedleSrc>
+    requires CanBeDelimiterOf<NeedleSrc, TextSrc>
+Index find(Exec& executor, const TextSrc& t, const NeedleSrc& n, Index start = Start, Index end = End,
+           Index step = Step, Case sensitivity = Case::Sensitive)
+{
+    using E = container_type_t<TextSrc>;
+    Text text(t);
+    detail::NeedleMatcher<E, NeedleSrc> matcher(n, sensitivity);
+    const auto lattice =
+        detail::match_lattice(text.length, matcher.size(), detail::find_start(start, text.length, step), end, step);
+    if (!lattice)
+        return End;
+    return detail::parallel_find(executor, text.ptr, text.length, matcher, *lattice);
+}
+
+template <Executor Exec, typename TextSrc, typename NeedleSrc>
+    requires CanBeDelimiterOf<NeedleSrc, TextSrc>
+Index find_any(Exec& executor, const TextSrc& t, const NeedleSrc& d, Index start = Start, Index end = End,
+               Index step = Step, Case sensitivity = Case::Sensitive)
+{
+    using E = container_type_t<TextSrc>;
+    Text text(t);
+    detail::AnyMatcher<E, NeedleSrc> matcher(d, sensitivity);
+    const auto lattice = detail::match_lattice(text.length, 1, detail::find_start(start, text.length, step), end, step);
+    if (!lattice)
+        return End;
+    return detail::parallel_find(executor, text.ptr, text.length, matcher, *lattice);
+}
+
+} // namespace Text
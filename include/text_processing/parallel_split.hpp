@@ -0,0 +1,134 @@
+#pragma once
+
+#include "common.hpp"
+#include "executor.hpp"
+#include "find_all.hpp"
+#include "split.hpp"
+
+#include <thread>
+#include <vector>
+
+namespace detail {
+
+// Texts shorter than this per thread are not worth splitting concurrently when thread count is not given
+constexpr size_t parallel_min_chunk = size_t{1} << 20;
+
+// Split in three passes: lattice matches of every chunk are found concurrently (a match may start in a chunk and
+// end in the next one), then matches overlapping a previously taken one are dropped sequentially exactly like
+// Splitter skips them, and finally fragments are written concurrently into their final slots.
+template <typename E, typename Matcher>
+std::vector<std::basic_string_view<E>> parallel_split_all(const E* ptr, size_t length, const Matcher& matcher,
+                                                          Text::SplitBehavior beh, Text::Index start, Text::Index end,
+                                                          Text::Index step, size_t threads)
+{
+    auto sequential = [&] { return split_all(Splitter<E, Matcher>(ptr, length, matcher, beh, start, end, step)); };
+    const auto match_length = static_cast<Text::Index>(matcher.size());
+    if (length == 0 || step <= 0 || match_length == 0)
+        return sequential();
+    auto first = start;
+    auto last = end;
+    if (Text::sanitize_index(first, length) == Text::End || Text::sanitize_index(last, length) == Text::End ||
+        last - first < match_length)
+        return sequential();
+
+    // Lattice positions a match may start at
+    const auto positions = static_cast<size_t>((last - match_length - first) / step + 1);
+    if (threads == 0)
+        threads = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), length / parallel_min_chunk);
+    threads = std::min(threads, positions);
+    if (threads <= 1)
+        return sequential();
+
+    std::vector<std::vector<Text::Index>> matches(threads);
+    parallel_for(threads, [&](size_t chunk) {
+        const auto chunk_first = first + static_cast<Text::Index>(positions * chunk / threads) * step;
+        const auto chunk_last = first + static_cast<Text::Index>(positions * (chunk + 1) / threads - 1) * step;
+        find_all_into(MatchScanner<E, Matcher>(ptr, length, matcher, Text::MatchMode::Overlapping, chunk_first,
+                                               chunk_last + match_length, step),
+                      std::back_inserter(matches[chunk]));
+    });
+
+    // Take matches greedily, count fragments of every chunk and where its first fragment starts
+    const auto skip = match_length <= step ? step : (match_length + step - 1) / step * step;
+    std::vector<size_t> offsets(threads + 1);
+    std::vector<Text::Index> fragment_starts(threads + 1);
+    Text::Index allowed = first;
+    Text::Index fragment_start = 0;
+    for (size_t chunk = 0; chunk < threads; ++chunk)
+    {
+        fragment_starts[chunk] = fragment_start;
+        size_t count = 0;
+        auto& found = matches[chunk];
+        size_t kept = 0;
+        for (auto match : found)
+        {
+            if (match < allowed)
+                continue;
+            found[kept++] = match;
+            allowed = match + skip;
+            count += match != fragment_start || beh == Text::SplitBehavior::KeepEmpty;
+            fragment_start = match + match_length;
+        }
+        found.resize(kept);
+        offsets[chunk + 1] = offsets[chunk] + count;
+    }
+    fragment_starts[threads] = fragment_start;
+    const bool has_tail = fragment_start != static_cast<Text::Index>(length) || beh == Text::SplitBehavior::KeepEmpty;
+
+    std::vector<std::basic_string_view<E>> results(offsets[threads] + has_tail);
+    parallel_for(threads, [&](size_t chunk) {
+        auto slot = offsets[chunk];
+        auto current = fragment_starts[chunk];
+        for (auto match : matches[chunk])
+        {
+            if (match != current || beh == Text::SplitBehavior::KeepEmpty)
+                results[slot++] = {ptr + current, static_cast<size_t>(match - current)};
+            current = match + match_length;
+        }
+    });
+    if (has_tail)
+        results.back() = {ptr + fragment_start, length - static_cast<size_t>(fragment_start)};
+    return results;
+}
+
+} // namespace detail
+
+namespace Text {
+
+// Same result as split, the text is searched by several threads (threads = 0 picks a count suitable for text
+// length and the machine). Single element needles and predicates are copied for every thread.
+template <typename TextSrc, typename DelimSrc>
+    requires CanBeDelimiterOf<DelimSrc, TextSrc>
+auto parallel_split(const TextSrc& t, const DelimSrc& d, SplitBehavior beh = SplitBehavior::KeepEmpty,
+                    Index start = Start, Index end = End, Index step = Step, Case sensitivity = Case::Sensitive,
+                    size_t threads = 0)
+{
+    using E = container_type_t<TextSrc>;
+    Text text(t);
+    return detail::parallel_split_all(text.ptr, text.length, detail::NeedleMatcher<E, DelimSrc>(d, sensitivity), beh,
+                                      start, end, step, threads);
+}
+
+template <typename TextSrc, typename DelimSrc>
+    requires CanBeDelimiterOf<DelimSrc, TextSrc>
+auto parallel_split_any(const TextSrc& t, const DelimSrc& d, SplitBehavior beh = SplitBehavior::KeepEmpty,
+                        Index start = Start, Index end = End, Index step = Step, Case sensitivity = Case::Sensitive,
+                        size_t threads = 0)
+{
+    using E = container_type_t<TextSrc>;
+    Text text(t);
+    return detail::parallel_split_all(text.ptr, text.length, detail::AnyMatcher<E, DelimSrc>(d, sensitivity), beh,
+                                      start, end, step, threads);
+}
+
+template <typename TextSrc, typename Predicate>
+auto parallel_split_if(const TextSrc& t, Predicate pred, SplitBehavior beh = SplitBehavior::KeepEmpty,
+                       Index start = Start, Index end = End, Index step = Step, size_t threads = 0)
+{
+    using E = container_type_t<TextSrc>;
+    Text text(t);
+    return detail::parallel_split_all(text.ptr, text.length, detail::PredicateMatcher<E, Predicate>{std::move(pred)},
+                                      beh, start, end, step, threads);
+}
+
+} // namespace Text
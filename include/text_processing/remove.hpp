@@ -2,100 +2,263 @@
 
 #include "common.hpp"
 #include "join.hpp"
+#include "replace.hpp"
 #include "split.hpp"
 
+#include <algorithm>
+#include <array>
+#include <optional>
+
+namespace detail {
+
+// Single element matches are removed from [start, end) in one compacting pass, kept elements slide forward.
+// Other matchers and steps reuse in place replacement with an empty replacement. Steps that are not positive
+// leave the text untouched, like they do for replace.
+template <typename E, typename StringAlloc, typename Matcher>
+std::optional<Text::Index> remove_in_place(std::basic_string<E, std::char_traits<E>, StringAlloc>& t, Matcher matcher,
+                                           Text::Index start, Text::Index end, Text::Index step)
+{
+    if (step <= 0)
+        return 0;
+    if constexpr (requires(E* ptr) { matcher.remove_into(ptr, ptr, ptr); })
+    {
+        if (step == 1)
+        {
+            if (Text::sanitize_index(start, t.size()) == Text::End ||
+                Text::sanitize_index(end, t.size()) == Text::End || start >= end)
+                return 0;
+            auto* last = t.data() + end;
+            auto* kept = matcher.remove_into(t.data() + start, last, t.data() + start);
+            const auto removed = last - kept;
+            std::char_traits<E>::move(kept, last, t.size() - static_cast<size_t>(end));
+            t.resize(t.size() - static_cast<size_t>(removed));
+            return removed;
+        }
+    }
+    return replace_in_place(t, std::move(matcher), t.data(), 0, start, end, step);
+}
+
+// Elements compacted at once by removed_into, small enough for the scratch block to stay in L1 cache
+constexpr size_t removal_block = 2048;
+
+// Copies fragments left after removal to out, the same way remove_impl joins them. Single element matches with
+// step 1 are removed by a compacting copy when out is a pointer. Compaction writes up to the end of the range it
+// is given, so blocks are compacted into a scratch buffer and only kept elements are written to out.
+template <typename E, typename Matcher, typename OutputIt>
+OutputIt removed_into(const E* ptr, size_t length, Matcher matcher, OutputIt out, Text::Index start, Text::Index end,
+                      Text::Index step)
+{
+    if (step <= 0 || Text::sanitize_index(start, length) == Text::End ||
+        Text::sanitize_index(end, length) == Text::End)
+        return std::copy(ptr, ptr + length, out);
+    if constexpr (std::same_as<OutputIt, E*> && std::is_default_constructible_v<E> &&
+                  requires(E* dest) { matcher.remove_into(ptr, ptr, dest); })
+    {
+        if (step == 1 && start < end)
+        {
+            out = std::copy(ptr, ptr + start, out);
+            std::array<E, removal_block> scratch;
+            for (auto* first = ptr + start; first < ptr + end; first += removal_block)
+            {
+                const auto* last = first + std::min(removal_block, static_cast<size_t>(ptr + end - first));
+                out = std::copy(scratch.data(), matcher.remove_into(first, last, scratch.data()), out);
+            }
+            return std::copy(ptr + end, ptr + length, out);
+        }
+    }
+    Splitter<E, Matcher> splitter(ptr, length, std::move(matcher), Text::SplitBehavior::KeepEmpty, start, end, step);
+    for (auto cursor = splitter.begin(); cursor.stage != SplitCursor<E>::Stage::Done; splitter.advance(cursor))
+        out = std::copy(cursor.fragment.begin(), cursor.fragment.end(), out);
+    return out;
+}
+
+} // namespace detail
+
 namespace Text {
-template <typename T>
+template <typename T, typename Alloc = std::allocator<T>>
 struct RemoveResult
 {
-    std::basic_string<T> text;
-    int operations = 0;
+    std::basic_string<T, std::char_traits<T>, Alloc> text;
+    Index operations = 0;
 };
 
-template <typename TextSrc, typename NeedleSrc, typename TextT = container_type_t<TextSrc>>
+namespace pmr {
+template <typename T>
+using RemoveResult = ::Text::RemoveResult<T, std::pmr::polymorphic_allocator<T>>;
+} // namespace pmr
+
+template <typename TextSrc, typename NeedleSrc, typename TextT = container_type_t<TextSrc>,
+          typename Alloc = std::allocator<TextT>>
     requires CanBeDelimiterOf<NeedleSrc, TextSrc>
-auto remove_impl(const TextSrc& t, const NeedleSrc& n, int start, int end, int step, Case sensitivity)
-    -> RemoveResult<TextT>
+auto remove_impl(const TextSrc& t, const NeedleSrc& n, Index start, Index end, Index step, Case sensitivity,
+                 const Alloc& alloc = Alloc()) -> RemoveResult<TextT, detail::rebind_alloc<TextT, Alloc>>
 {
     Text txt(t);
-    if (sanitize_index(start, txt.length) == End || sanitize_index(end, txt.length) == End)
-        return {std::basic_string(t)};
-    auto splitted = split(t, n, SplitBehavior::KeepEmpty, start, end, step, sensitivity);
-    return {join(splitted, std::basic_string_view<TextT>{}), static_cast<int>(splitted.size()) - 1};
+    if (step <= 0 || sanitize_index(start, txt.length) == End || sanitize_index(end, txt.length) == End)
+        return {detail::AllocString<TextT, Alloc>(txt.ptr, txt.length, alloc)};
+    auto splitted = split(std::allocator_arg, alloc, t, n, SplitBehavior::KeepEmpty, start, end, step, sensitivity);
+    return {join(std::allocator_arg, alloc, splitted, std::basic_string_view<TextT>{}),
+            static_cast<Index>(splitted.size()) - 1};
 }
 
-template <typename TextT, typename NeedleSrc>
+template <typename TextT, typename StringAlloc, typename NeedleSrc>
     requires CanBeDelimiterOf<NeedleSrc, TextT>
-int remove(std::basic_string<TextT>& t, const NeedleSrc& n, int start = Start, int end = End, int step = Step,
-           Case sensitivity = Case::Sensitive)
+Index remove(std::basic_string<TextT, std::char_traits<TextT>, StringAlloc>& t, const NeedleSrc& n, Index start = Start,
+             Index end = End, Index step = Step, Case sensitivity = Case::Sensitive)
 {
-    auto result = remove_impl(t, n, start, end, step, sensitivity);
+    if (auto operations =
+            detail::remove_in_place(t, detail::NeedleMatcher<TextT, NeedleSrc>(n, sensitivity), start, end, step))
+        return *operations;
+    auto result = remove_impl(t, n, start, end, step, sensitivity, t.get_allocator());
     t = std::move(result.text);
     return result.operations;
 }
 
+// Result is a copy of the text compacted in place, allocated with given allocator
+template <typename Alloc, typename TextSrc, typename NeedleSrc, typename TextT = container_type_t<TextSrc>>
+    requires CanBeDelimiterOf<NeedleSrc, TextSrc>
+[[nodiscard]] auto removed(std::allocator_arg_t, const Alloc& alloc, const TextSrc& t, const NeedleSrc& n,
+                           Index start = Start, Index end = End, Index step = Step,
+                           Case sensitivity = Case::Sensitive) -> detail::AllocString<TextT, Alloc>
+{
+    Text txt(t);
+    detail::AllocString<TextT, Alloc> result(txt.ptr, txt.length, alloc);
+    remove(result, n, start, end, step, sensitivity);
+    return result;
+}
+
 template <typename TextSrc, typename NeedleSrc, typename TextT = container_type_t<TextSrc>>
     requires CanBeDelimiterOf<NeedleSrc, TextSrc>
-[[nodiscard]] auto removed(const TextSrc& t, const NeedleSrc& n, int start = Start, int end = End, int step = Step,
-                           Case sensitivity = Case::Sensitive) -> std::basic_string<TextT>
+[[nodiscard]] auto removed(const TextSrc& t, const NeedleSrc& n, Index start = Start, Index end = End,
+                           Index step = Step, Case sensitivity = Case::Sensitive) -> std::basic_string<TextT>
 {
-    return remove_impl(t, n, start, end, step, sensitivity).text;
+    return removed(std::allocator_arg, std::allocator<TextT>(), t, n, start, end, step, sensitivity);
 }
 
-template <typename TextSrc, typename Predicate, typename TextT = container_type_t<TextSrc>>
-auto remove_if_impl(const TextSrc& t, Predicate pred, int start = Start, int end = End, int step = Step)
-    -> RemoveResult<TextT>
+// Writes text without removed parts to out (which must not overlap the text), returns end of written elements.
+// Nothing is written after the returned end, so a caller buffer only needs room for the result.
+template <typename TextSrc, typename NeedleSrc, typename OutputIt>
+    requires CanBeDelimiterOf<NeedleSrc, TextSrc>
+OutputIt removed_into(const TextSrc& t, const NeedleSrc& n, OutputIt out, Index start = Start, Index end = End,
+                      Index step = Step, Case sensitivity = Case::Sensitive)
+{
+    using E = container_type_t<TextSrc>;
+    Text text(t);
+    return detail::removed_into(text.ptr, text.length, detail::NeedleMatcher<E, NeedleSrc>(n, sensitivity), out,
+                                start, end, step);
+}
+
+template <typename TextSrc, typename Predicate, typename TextT = container_type_t<TextSrc>,
+          typename Alloc = std::allocator<TextT>>
+auto remove_if_impl(const TextSrc& t, Predicate pred, Index start = Start, Index end = End, Index step = Step,
+                    const Alloc& alloc = Alloc()) -> RemoveResult<TextT, detail::rebind_alloc<TextT, Alloc>>
 {
     Text txt(t);
-    if (sanitize_index(start, txt.length) == End || sanitize_index(end, txt.length) == End)
-        return {std::basic_string(t)};
-    auto splitted = split_if(t, pred, SplitBehavior::KeepEmpty, start, end, step);
-    return {join(splitted, std::basic_string_view<TextT>{}), static_cast<int>(splitted.size()) - 1};
+    if (step <= 0 || sanitize_index(start, txt.length) == End || sanitize_index(end, txt.length) == End)
+        return {detail::AllocString<TextT, Alloc>(txt.ptr, txt.length, alloc)};
+    auto splitted = split_if(std::allocator_arg, alloc, t, pred, SplitBehavior::KeepEmpty, start, end, step);
+    return {join(std::allocator_arg, alloc, splitted, std::basic_string_view<TextT>{}),
+            static_cast<Index>(splitted.size()) - 1};
 }
 
-template <typename TextT, typename Predicate>
-int remove_if(std::basic_string<TextT>& t, Predicate pred, int start = Start, int end = End, int step = Step)
+template <typename TextT, typename StringAlloc, typename Predicate>
+Index remove_if(std::basic_string<TextT, std::char_traits<TextT>, StringAlloc>& t, Predicate pred, Index start = Start,
+                Index end = End, Index step = Step)
 {
-    auto result = remove_if_impl(t, pred, start, end, step);
+    if (auto operations =
+            detail::remove_in_place(t, detail::PredicateMatcher<TextT, Predicate>{pred}, start, end, step))
+        return *operations;
+    auto result = remove_if_impl(t, pred, start, end, step, t.get_allocator());
     t = std::move(result.text);
     return result.operations;
 }
 
+template <typename Alloc, typename TextSrc, typename Predicate, typename TextT = container_type_t<TextSrc>>
+[[nodiscard]] auto removed_if(std::allocator_arg_t, const Alloc& alloc, const TextSrc& t, Predicate pred,
+                              Index start = Start, Index end = End, Index step = Step)
+    -> detail::AllocString<TextT, Alloc>
+{
+    Text txt(t);
+    detail::AllocString<TextT, Alloc> result(txt.ptr, txt.length, alloc);
+    remove_if(result, std::move(pred), start, end, step);
+    return result;
+}
+
 template <typename TextSrc, typename Predicate, typename TextT = container_type_t<TextSrc>>
-[[nodiscard]] auto removed_if(const TextSrc& t, Predicate pred, int start = Start, int end = End, int step = Step)
+[[nodiscard]] auto removed_if(const TextSrc& t, Predicate pred, Index start = Start, Index end = End, Index step = Step)
     -> std::basic_string<TextT>
 {
-    return remove_if_impl(t, pred, start, end, step).text;
+    return removed_if(std::allocator_arg, std::allocator<TextT>(), t, std::move(pred), start, end, step);
 }
 
-template <typename TextSrc, typename NeedleSrc, typename TextT = container_type_t<TextSrc>>
+template <typename TextSrc, typename Predicate, typename OutputIt>
+OutputIt removed_if_into(const TextSrc& t, Predicate pred, OutputIt out, Index start = Start, Index end = End,
+                         Index step = Step)
+{
+    using E = container_type_t<TextSrc>;
+    Text text(t);
+    return detail::removed_into(text.ptr, text.length, detail::PredicateMatcher<E, Predicate>{std::move(pred)}, out,
+                                start, end, step);
+}
+
+template <typename TextSrc, typename NeedleSrc, typename TextT = container_type_t<TextSrc>,
+          typename Alloc = std::allocator<TextT>>
     requires CanBeDelimiterOf<NeedleSrc, TextSrc>
-auto remove_any_impl(const TextSrc& t, const NeedleSrc& d, int start = Start, int end = End, int step = Step,
-                     Case sensitivity = Case::Sensitive) -> RemoveResult<TextT>
+auto remove_any_impl(const TextSrc& t, const NeedleSrc& d, Index start = Start, Index end = End, Index step = Step,
+                     Case sensitivity = Case::Sensitive, const Alloc& alloc = Alloc())
+    -> RemoveResult<TextT, detail::rebind_alloc<TextT, Alloc>>
 {
     Text txt(t);
-    if (sanitize_index(start, txt.length) == End || sanitize_index(end, txt.length) == End)
-        return {std::basic_string(t)};
-    auto splitted = split_any(t, d, SplitBehavior::KeepEmpty, start, end, step, sensitivity);
-    return {join(splitted, std::basic_string_view<TextT>{}), static_cast<int>(splitted.size()) - 1};
+    if (step <= 0 || sanitize_index(start, txt.length) == End || sanitize_index(end, txt.length) == End)
+        return {detail::AllocString<TextT, Alloc>(txt.ptr, txt.length, alloc)};
+    auto splitted =
+        split_any(std::allocator_arg, alloc, t, d, SplitBehavior::KeepEmpty, start, end, step, sensitivity);
+    return {join(std::allocator_arg, alloc, splitted, std::basic_string_view<TextT>{}),
+            static_cast<Index>(splitted.size()) - 1};
 }
 
-template <typename TextT, typename NeedleSrc>
+template <typename TextT, typename StringAlloc, typename NeedleSrc>
     requires CanBeDelimiterOf<NeedleSrc, TextT>
-int remove_any(std::basic_string<TextT>& t, const NeedleSrc& d, int start = Start, int end = End, int step = Step,
-               Case sensitivity = Case::Sensitive)
+Index remove_any(std::basic_string<TextT, std::char_traits<TextT>, StringAlloc>& t, const NeedleSrc& d,
+                 Index start = Start, Index end = End, Index step = Step, Case sensitivity = Case::Sensitive)
 {
-    auto result = remove_any_impl(t, d, start, end, step, sensitivity);
+    if (auto operations =
+            detail::remove_in_place(t, detail::AnyMatcher<TextT, NeedleSrc>(d, sensitivity), start, end, step))
+        return *operations;
+    auto result = remove_any_impl(t, d, start, end, step, sensitivity, t.get_allocator());
     t = std::move(result.text);
     return result.operations;
 }
 
+template <typename Alloc, typename TextSrc, typename NeedleSrc, typename TextT = container_type_t<TextSrc>>
+    requires CanBeDelimiterOf<NeedleSrc, TextSrc>
+[[nodiscard]] auto removed_any(std::allocator_arg_t, const Alloc& alloc, const TextSrc& t, const NeedleSrc& d,
+                               Index start = Start, Index end = End, Index step = Step,
+                               Case sensitivity = Case::Sensitive) -> detail::AllocString<TextT, Alloc>
+{
+    Text txt(t);
+    detail::AllocString<TextT, Alloc> result(txt.ptr, txt.length, alloc);
+    remove_any(result, d, start, end, step, sensitivity);
+    return result;
+}
+
 template <typename TextSrc, typename NeedleSrc, typename TextT = container_type_t<TextSrc>>
     requires CanBeDelimiterOf<NeedleSrc, TextSrc>
-[[nodiscard]] auto removed_any(const TextSrc& t, const NeedleSrc& d, int start = Start, int end = End, int step = Step,
-                               Case sensitivity = Case::Sensitive) -> std::basic_string<TextT>
+[[nodiscard]] auto removed_any(const TextSrc& t, const NeedleSrc& d, Index start = Start, Index end = End,
+                               Index step = Step, Case sensitivity = Case::Sensitive) -> std::basic_string<TextT>
+{
+    return removed_any(std::allocator_arg, std::allocator<TextT>(), t, d, start, end, step, sensitivity);
+}
+
+template <typename TextSrc, typename NeedleSrc, typename OutputIt>
+    requires CanBeDelimiterOf<NeedleSrc, TextSrc>
+OutputIt removed_any_into(const TextSrc& t, const NeedleSrc& d, OutputIt out, Index start = Start, Index end = End,
+                          Index step = Step, Case sensitivity = Case::Sensitive)
 {
-    return remove_any_impl(t, d, start, end, step, sensitivity).text;
+    using E = container_type_t<TextSrc>;
+    Text text(t);
+    return detail::removed_into(text.ptr, text.length, detail::AnyMatcher<E, NeedleSrc>(d, sensitivity), out, start,
+                                end, step);
 }
 
 } // namespace Text
\ No newline at end of file
@@ -4,103 +4,203 @@
 #include "join.hpp"
 #include "split.hpp"
 
+#include <optional>
+
+namespace detail {
+
+// Rewrites text in one forward pass when replacement is not longer than a match: every kept fragment is moved
+// left by what previous replacements saved, so nothing is read after it was overwritten. Returns number of
+// replacements, or nothing when replacement is longer and text has to be rebuilt.
+template <typename E, typename StringAlloc, typename Matcher>
+std::optional<Text::Index> replace_in_place(std::basic_string<E, std::char_traits<E>, StringAlloc>& t, Matcher matcher,
+                                            const E* replacement, size_t replacement_length, Text::Index start,
+                                            Text::Index end, Text::Index step)
+{
+    if (matcher.size() == 0 || replacement_length > matcher.size())
+        return std::nullopt;
+    if (step <= 0)
+        return 0;
+
+    Splitter<E, Matcher> splitter(t.data(), t.size(), std::move(matcher), Text::SplitBehavior::KeepEmpty, start, end,
+                                  step);
+    const auto* text = t.data();
+    auto* data = t.data();
+    auto* out = data;
+    Text::Index operations = 0;
+    for (auto cursor = splitter.begin(); cursor.stage != SplitCursor<E>::Stage::Done; splitter.advance(cursor))
+    {
+        const auto& fragment = cursor.fragment;
+        auto* in = data + (fragment.data() - text);
+        if (out != in)
+            std::char_traits<E>::move(out, in, fragment.size());
+        out += fragment.size();
+        if (cursor.stage == SplitCursor<E>::Stage::Last)
+            break;
+        std::char_traits<E>::copy(out, replacement, replacement_length);
+        out += replacement_length;
+        ++operations;
+    }
+    t.resize(static_cast<size_t>(out - data));
+    return operations;
+}
+
+} // namespace detail
+
 namespace Text {
-constexpr int all = -1;
+constexpr Index all = -1;
 
-template <typename T>
+template <typename T, typename Alloc = std::allocator<T>>
 struct ReplaceResult
 {
-    std::basic_string<T> text;
-    int operations = 0;
+    std::basic_string<T, std::char_traits<T>, Alloc> text;
+    Index operations = 0;
 };
 
-template <typename TextSrc, typename NeedleSrc, typename ReplaceSrc, typename TextT = container_type_t<TextSrc>>
+namespace pmr {
+template <typename T>
+using ReplaceResult = ::Text::ReplaceResult<T, std::pmr::polymorphic_allocator<T>>;
+} // namespace pmr
+
+template <typename TextSrc, typename NeedleSrc, typename ReplaceSrc, typename TextT = container_type_t<TextSrc>,
+          typename Alloc = std::allocator<TextT>>
     requires CanBeDelimiterOf<NeedleSrc, TextSrc> &&
              SameDataType<NeedleSrc, ReplaceSrc>
-             auto replace_impl(const TextSrc& t, const NeedleSrc& n, const ReplaceSrc& r, int start, int end, int step,
-                               Case sensitivity) -> ReplaceResult<TextT>
+             auto replace_impl(const TextSrc& t, const NeedleSrc& n, const ReplaceSrc& r, Index start, Index end,
+                               Index step, Case sensitivity, const Alloc& alloc = Alloc())
+                 -> ReplaceResult<TextT, detail::rebind_alloc<TextT, Alloc>>
 {
-    if (sanitize_index(start, t.length()) == End || sanitize_index(end, t.length()) == End)
-        return {std::basic_string(t)};
-    auto splitted = split(t, n, SplitBehavior::KeepEmpty, start, end, step, sensitivity);
-    return {join(splitted, r), static_cast<int>(splitted.size()) - 1};
+    if (step <= 0 || sanitize_index(start, t.length()) == End || sanitize_index(end, t.length()) == End)
+        return {detail::AllocString<TextT, Alloc>(t.data(), t.length(), alloc)};
+    auto splitted = split(std::allocator_arg, alloc, t, n, SplitBehavior::KeepEmpty, start, end, step, sensitivity);
+    return {join(std::allocator_arg, alloc, splitted, r), static_cast<Index>(splitted.size()) - 1};
 }
 
-template <typename TextT, typename NeedleSrc, typename ReplaceSrc>
+template <typename TextT, typename StringAlloc, typename NeedleSrc, typename ReplaceSrc>
     requires CanBeDelimiterOf<NeedleSrc, TextT> && SameDataType<NeedleSrc, ReplaceSrc>
-int replace(std::basic_string<TextT>& t, const NeedleSrc& n, const ReplaceSrc& r, int start = Start, int end = End,
-            int step = Step, Case sensivity = Case::Insensitive)
+Index replace(std::basic_string<TextT, std::char_traits<TextT>, StringAlloc>& t, const NeedleSrc& n,
+              const ReplaceSrc& r, Index start = Start, Index end = End, Index step = Step,
+              Case sensivity = Case::Insensitive)
 {
-    auto result = replace_impl(t, n, r, start, end, step, sensivity);
+    Delimiter replacement(r);
+    if (auto operations = detail::replace_in_place(t, detail::NeedleMatcher<TextT, NeedleSrc>(n, sensivity),
+                                                   replacement.ptr, replacement.length, start, end, step))
+        return *operations;
+    auto result = replace_impl(t, n, r, start, end, step, sensivity, t.get_allocator());
     t = std::move(result.text);
     return result.operations;
 }
 
+// Result string and intermediate fragments are allocated with given allocator
+template <typename Alloc, typename TextSrc, typename NeedleSrc, typename ReplaceSrc,
+          typename TextT = container_type_t<TextSrc>>
+    requires CanBeDelimiterOf<NeedleSrc, TextSrc> &&
+             SameDataType<NeedleSrc, ReplaceSrc>
+             auto replaced(std::allocator_arg_t, const Alloc& alloc, const TextSrc& t, const NeedleSrc& n,
+                           const ReplaceSrc& r, Index start = Start, Index end = End, Index step = Step,
+                           Case sensitivity = Case::Sensitive) -> detail::AllocString<TextT, Alloc>
+{
+    return replace_impl(t, n, r, start, end, step, sensitivity, alloc).text;
+}
+
 template <typename TextSrc, typename NeedleSrc, typename ReplaceSrc, typename TextT = container_type_t<TextSrc>>
     requires CanBeDelimiterOf<NeedleSrc, TextSrc> &&
              SameDataType<NeedleSrc, ReplaceSrc>
-             auto replaced(const TextSrc& t, const NeedleSrc& n, const ReplaceSrc& r, int start = Start, int end = End,
-                           int step = Step, Case sensitivity = Case::Sensitive) -> std::basic_string<TextT>
+             auto replaced(const TextSrc& t, const NeedleSrc& n, const ReplaceSrc& r, Index start = Start,
+                           Index end = End, Index step = Step, Case sensitivity = Case::Sensitive)
+                 -> std::basic_string<TextT>
 {
     return replace_impl(t, n, r, start, end, step, sensitivity).text;
 }
 
-template <typename TextSrc, typename Predicate, typename ReplaceSrc, typename TextT = container_type_t<TextSrc>>
+template <typename TextSrc, typename Predicate, typename ReplaceSrc, typename TextT = container_type_t<TextSrc>,
+          typename Alloc = std::allocator<TextT>>
     requires SameDataType<TextSrc, ReplaceSrc>
-auto replace_if_impl(const TextSrc& t, Predicate pred, const ReplaceSrc& r, int start, int end, int step)
-    -> ReplaceResult<TextT>
+auto replace_if_impl(const TextSrc& t, Predicate pred, const ReplaceSrc& r, Index start, Index end, Index step,
+                     const Alloc& alloc = Alloc()) -> ReplaceResult<TextT, detail::rebind_alloc<TextT, Alloc>>
 {
-    if (sanitize_index(start, t.length()) == End || sanitize_index(end, t.length()) == End)
-        return {std::basic_string(t)};
-    auto splitted = split_if(t, pred, SplitBehavior::KeepEmpty, start, end, step);
-    return {join(splitted, r), static_cast<int>(splitted.size()) - 1};
+    if (step <= 0 || sanitize_index(start, t.length()) == End || sanitize_index(end, t.length()) == End)
+        return {detail::AllocString<TextT, Alloc>(t.data(), t.length(), alloc)};
+    auto splitted = split_if(std::allocator_arg, alloc, t, pred, SplitBehavior::KeepEmpty, start, end, step);
+    return {join(std::allocator_arg, alloc, splitted, r), static_cast<Index>(splitted.size()) - 1};
 }
 
-template <typename TextT, typename Predicate, typename ReplaceSrc>
+template <typename TextT, typename StringAlloc, typename Predicate, typename ReplaceSrc>
     requires SameDataType<TextT, ReplaceSrc>
-int replace_if(std::basic_string<TextT>& t, Predicate pred, const ReplaceSrc& r, int start = Start, int end = End,
-               int step = Step)
+Index replace_if(std::basic_string<TextT, std::char_traits<TextT>, StringAlloc>& t, Predicate pred, const ReplaceSrc& r,
+                 Index start = Start, Index end = End, Index step = Step)
 {
-    auto result = replace_if_impl(t, pred, r, start, end, step);
+    Delimiter replacement(r);
+    if (auto operations = detail::replace_in_place(t, detail::PredicateMatcher<TextT, Predicate>{pred},
+                                                   replacement.ptr, replacement.length, start, end, step))
+        return *operations;
+    auto result = replace_if_impl(t, pred, r, start, end, step, t.get_allocator());
     t = std::move(result.text);
     return result.operations;
 }
 
+template <typename Alloc, typename TextSrc, typename Predicate, typename ReplaceSrc,
+          typename TextT = container_type_t<TextSrc>>
+    requires SameDataType<TextSrc, ReplaceSrc>
+auto replaced_if(std::allocator_arg_t, const Alloc& alloc, const TextSrc& t, Predicate pred, const ReplaceSrc& r,
+                 Index start = Start, Index end = End, Index step = Step) -> detail::AllocString<TextT, Alloc>
+{
+    return replace_if_impl(t, pred, r, start, end, step, alloc).text;
+}
+
 template <typename TextSrc, typename Predicate, typename ReplaceSrc, typename TextT = container_type_t<TextSrc>>
     requires SameDataType<TextSrc, ReplaceSrc>
-auto replaced_if(const TextSrc& t, Predicate pred, const ReplaceSrc& r, int start = Start, int end = End,
-                 int step = Step) -> std::basic_string<TextT>
+auto replaced_if(const TextSrc& t, Predicate pred, const ReplaceSrc& r, Index start = Start, Index end = End,
+                 Index step = Step) -> std::basic_string<TextT>
 {
     return replace_if_impl(t, pred, r, start, end, step).text;
 }
 
-template <typename TextSrc, typename NeedleSrc, typename ReplaceSrc, typename TextT = container_type_t<TextSrc>>
+template <typename TextSrc, typename NeedleSrc, typename ReplaceSrc, typename TextT = container_type_t<TextSrc>,
+          typename Alloc = std::allocator<TextT>>
     requires CanBeDelimiterOf<NeedleSrc, TextSrc> &&
              SameDataType<NeedleSrc, ReplaceSrc>
-             auto replace_any_impl(const TextSrc& t, const NeedleSrc& d, const ReplaceSrc& r, int start, int end,
-                                   int step, Case sensitivity) -> ReplaceResult<TextT>
+             auto replace_any_impl(const TextSrc& t, const NeedleSrc& d, const ReplaceSrc& r, Index start, Index end,
+                                   Index step, Case sensitivity, const Alloc& alloc = Alloc())
+                 -> ReplaceResult<TextT, detail::rebind_alloc<TextT, Alloc>>
 {
-    if (sanitize_index(start, t.length()) == End || sanitize_index(end, t.length()) == End)
-        return {std::basic_string(t)};
-    auto splitted = split_any(t, d, SplitBehavior::KeepEmpty, start, end, step, sensitivity);
-    return {join(splitted, r), static_cast<int>(splitted.size()) - 1};
+    if (step <= 0 || sanitize_index(start, t.length()) == End || sanitize_index(end, t.length()) == End)
+        return {detail::AllocString<TextT, Alloc>(t.data(), t.length(), alloc)};
+    auto splitted =
+        split_any(std::allocator_arg, alloc, t, d, SplitBehavior::KeepEmpty, start, end, step, sensitivity);
+    return {join(std::allocator_arg, alloc, splitted, r), static_cast<Index>(splitted.size()) - 1};
 }
 
-template <typename TextT, typename NeedleSrc, typename ReplaceSrc>
+template <typename TextT, typename StringAlloc, typename NeedleSrc, typename ReplaceSrc>
     requires CanBeDelimiterOf<NeedleSrc, TextT> && SameDataType<NeedleSrc, ReplaceSrc>
-int replace_any(std::basic_string<TextT>& t, const NeedleSrc& d, const ReplaceSrc& r, int start = Start, int end = End,
-                int step = Step, Case sensitivity = Case::Sensitive)
+Index replace_any(std::basic_string<TextT, std::char_traits<TextT>, StringAlloc>& t, const NeedleSrc& d,
+                  const ReplaceSrc& r, Index start = Start, Index end = End, Index step = Step,
+                  Case sensitivity = Case::Sensitive)
 {
-    auto result = replace_any_impl(t, d, r, start, end, step, sensitivity);
+    Delimiter replacement(r);
+    if (auto operations = detail::replace_in_place(t, detail::AnyMatcher<TextT, NeedleSrc>(d, sensitivity),
+                                                   replacement.ptr, replacement.length, start, end, step))
+        return *operations;
+    auto result = replace_any_impl(t, d, r, start, end, step, sensitivity, t.get_allocator());
     t = std::move(result.text);
     return result.operations;
 }
 
+template <typename Alloc, typename TextSrc, typename NeedleSrc, typename ReplaceSrc,
+          typename TextT = container_type_t<TextSrc>>
+    requires CanBeDelimiterOf<NeedleSrc, TextSrc> &&
+             SameDataType<NeedleSrc, ReplaceSrc>
+             auto replaced_any(std::allocator_arg_t, const Alloc& alloc, const TextSrc& t, const NeedleSrc& d,
+                               const ReplaceSrc& r, Index start = Start, Index end = End, Index step = Step,
+                               Case sensitivity = Case::Sensitive) -> detail::AllocString<TextT, Alloc>
+{
+    return replace_any_impl(t, d, r, start, end, step, sensitivity, alloc).text;
+}
+
 template <typename TextSrc, typename NeedleSrc, typename ReplaceSrc, typename TextT = container_type_t<TextSrc>>
     requires CanBeDelimiterOf<NeedleSrc, TextSrc> &&
              SameDataType<NeedleSrc, ReplaceSrc>
-             auto replaced_any(const TextSrc& t, const NeedleSrc& d, const ReplaceSrc& r, int start = Start,
-                               int end = End, int step = Step, Case sensitivity = Case::Sensitive)
+             auto replaced_any(const TextSrc& t, const NeedleSrc& d, const ReplaceSrc& r, Index start = Start,
+                               Index end = End, Index step = Step, Case sensitivity = Case::Sensitive)
                  -> std::basic_string<TextT>
 {
     return replace_any_impl(t, d, r, start, end, step, sensitivity).text;
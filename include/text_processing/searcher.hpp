@@ -0,0 +1,434 @@
+#pragma once
+
+#include "common.hpp"
+#include "simd.hpp"
+#include "two_way.hpp"
+
+#include <iterator>
+#include <optional>
+#include <variant>
+
+namespace detail {
+
+// Needles at least this long are searched with Two-Way, shorter ones are scanned directly. Byte texts have
+// a vectorized scan whose verification cost is bounded by needle length, so they switch later.
+template <typename E>
+constexpr size_t two_way_min_length = ByteChar<E> ? 33 : 4;
+
+// Two-Way needs totally ordered elements, other types are always scanned directly
+template <typename E>
+constexpr bool two_way_capable = std::is_integral_v<E> && !std::same_as<E, bool>;
+
+template <typename E>
+using OptionalTwoWay = std::conditional_t<two_way_capable<E>, std::optional<TwoWay<E>>, std::monostate>;
+
+// Non-owning description of a needle used by search loops. It either wraps needle passed directly
+// to an algorithm or refers to data precomputed by Text::Searcher. Tables for an ad-hoc needle are built
+// on first use and kept for following searches with the same pattern.
+template <typename E>
+struct Pattern
+{
+    const E* ptr = nullptr;
+    size_t length = 0;
+    Text::Case sensitivity = Text::Case::Sensitive;
+    // Needle is stored in caseless form, so only text elements have to be folded
+    bool folded = false;
+    const OptionalTwoWay<E>* forward = nullptr;
+    const OptionalTwoWay<E>* backward = nullptr;
+    OptionalTwoWay<E> local_forward{};
+    OptionalTwoWay<E> local_backward{};
+
+    constexpr E fold(E value) const
+    {
+        return sensitivity == Text::Case::Sensitive ? value : caseless(value);
+    }
+
+    constexpr E needle_at(size_t idx) const
+    {
+        return folded ? ptr[idx] : fold(ptr[idx]);
+    }
+
+    constexpr bool matches(const E* pos) const
+    {
+        if (!folded || sensitivity == Text::Case::Sensitive)
+            return Text::are_equal(pos, ptr, length, sensitivity);
+        for (size_t idx = 0; idx < length; ++idx)
+            if (!(caseless(pos[idx]) == ptr[idx]))
+                return false;
+        return true;
+    }
+
+    // Same as matches for a text that is not contiguous, e.g. a strided view
+    template <std::random_access_iterator It>
+    constexpr bool matches_at(It pos) const
+    {
+        for (size_t idx = 0; idx < length; ++idx)
+            if (!(fold(pos[idx]) == needle_at(idx)))
+                return false;
+        return true;
+    }
+
+    constexpr bool uses_two_way() const
+    {
+        return two_way_capable<E> && length >= two_way_min_length<E>;
+    }
+
+    // Returns first match fully contained in [first, last) or last if there is none
+    const E* find_in(const E* first, const E* last)
+    {
+        if (length == 0 || first >= last || static_cast<size_t>(last - first) < length)
+            return last;
+
+        if constexpr (two_way_capable<E>)
+        {
+            if (uses_two_way())
+            {
+                const auto& table = two_way(forward, local_forward, false);
+                const auto found = table.find([&](size_t idx) { return fold(first[idx]); },
+                                              static_cast<size_t>(last - first),
+                                              [&](size_t idx) { return needle_at(idx); }, length);
+                return found == TwoWay<E>::npos ? last : first + found;
+            }
+        }
+
+        if constexpr (ByteChar<E>)
+        {
+            if (!folded)
+                return find_bytes(first, last, ptr, length, sensitivity);
+            const auto* found =
+                simd::find_bytes(reinterpret_cast<const uint8_t*>(first), reinterpret_cast<const uint8_t*>(last),
+                                 reinterpret_cast<const uint8_t*>(ptr), length, folds_case<E>(sensitivity));
+            return reinterpret_cast<const E*>(found);
+        }
+        else
+        {
+            for (auto current = first; current + length <= last; ++current)
+                if (matches(current))
+                    return current;
+            return last;
+        }
+    }
+
+    // Returns last match fully contained in [first, last) or last if there is none
+    const E* rfind_in(const E* first, const E* last)
+    {
+        if (length == 0 || first >= last || static_cast<size_t>(last - first) < length)
+            return last;
+
+        if constexpr (two_way_capable<E>)
+        {
+            if (uses_two_way())
+            {
+                // Search for reversed needle in reversed text
+                const auto& table = two_way(backward, local_backward, true);
+                const auto found = table.find([&](size_t idx) { return fold(*(last - 1 - idx)); },
+                                              static_cast<size_t>(last - first),
+                                              [&](size_t idx) { return needle_at(length - 1 - idx); }, length);
+                return found == TwoWay<E>::npos ? last : last - found - length;
+            }
+        }
+
+        for (auto current = last - length;; --current)
+        {
+            if (matches(current))
+                return current;
+            if (current == first)
+                return last;
+        }
+    }
+
+    // Returns number of (possibly overlapping) matches fully contained in [first, last)
+    size_t count_in(const E* first, const E* last)
+    {
+        if (length == 0 || first >= last || static_cast<size_t>(last - first) < length)
+            return 0;
+
+        if constexpr (ByteChar<E>)
+        {
+            if (length == 1)
+            {
+                const auto byte = static_cast<uint8_t>(folded ? ptr[0] : fold(ptr[0]));
+                return simd::count_byte(reinterpret_cast<const uint8_t*>(first), reinterpret_cast<const uint8_t*>(last),
+                                        byte, folds_case<E>(sensitivity));
+            }
+        }
+
+        size_t cnt = 0;
+        for (auto current = find_in(first, last); current != last; current = find_in(current + 1, last))
+            ++cnt;
+        return cnt;
+    }
+
+private:
+    const TwoWay<E>& two_way(const OptionalTwoWay<E>* precomputed, OptionalTwoWay<E>& local, bool reversed)
+    {
+        if (precomputed != nullptr && precomputed->has_value())
+            return **precomputed;
+        if (!local.has_value())
+        {
+            if (reversed)
+                local.emplace([&](size_t idx) { return needle_at(length - 1 - idx); }, length);
+            else
+                local.emplace([&](size_t idx) { return needle_at(idx); }, length);
+        }
+        return *local;
+    }
+};
+
+// Single element delimiters used by search loops, with nibble tables for vectorized scan of byte texts
+template <typename E>
+struct AnyPattern
+{
+    const Text::Delimiters<E>* delimiters = nullptr;
+    std::conditional_t<ByteChar<E>, simd::ByteClass, std::monostate> byte_class{};
+
+    bool contains(E elem) const
+    {
+        return delimiters->contains(elem);
+    }
+
+    // Returns first delimiter in [first, last) or last if there is none
+    const E* find_in(const E* first, const E* last) const
+    {
+        if constexpr (ByteChar<E>)
+            return reinterpret_cast<const E*>(simd::find_class(reinterpret_cast<const uint8_t*>(first),
+                                                               reinterpret_cast<const uint8_t*>(last), byte_class));
+        else
+        {
+            for (auto current = first; current < last; ++current)
+                if (contains(*current))
+                    return current;
+            return last;
+        }
+    }
+
+    // Returns last delimiter in [first, last) or last if there is none
+    const E* rfind_in(const E* first, const E* last) const
+    {
+        if constexpr (ByteChar<E>)
+            return reinterpret_cast<const E*>(simd::rfind_class(reinterpret_cast<const uint8_t*>(first),
+                                                                reinterpret_cast<const uint8_t*>(last), byte_class));
+        else
+        {
+            for (auto current = last; current > first;)
+                if (contains(*--current))
+                    return current;
+            return last;
+        }
+    }
+
+    // Returns number of delimiters in [first, last)
+    size_t count_in(const E* first, const E* last) const
+    {
+        if constexpr (ByteChar<E>)
+            return simd::count_class(reinterpret_cast<const uint8_t*>(first), reinterpret_cast<const uint8_t*>(last),
+                                     byte_class);
+        else
+        {
+            size_t cnt = 0;
+            for (; first < last; ++first)
+                cnt += contains(*first);
+            return cnt;
+        }
+    }
+
+    // Copies elements of [first, last) that are not delimiters to out, which may be first but not after it and
+    // has to have room for the whole range. Returns end of copied elements.
+    E* remove_into(const E* first, const E* last, E* out) const
+    {
+        if constexpr (ByteChar<E>)
+            return reinterpret_cast<E*>(simd::remove_class(reinterpret_cast<const uint8_t*>(first),
+                                                           reinterpret_cast<const uint8_t*>(last),
+                                                           reinterpret_cast<uint8_t*>(out), byte_class));
+        else
+        {
+            for (; first < last; ++first)
+            {
+                *out = *first;
+                out += !contains(*first);
+            }
+            return out;
+        }
+    }
+};
+
+} // namespace detail
+
+namespace Text {
+
+// Needle preprocessed once and reusable with find/rfind/count/split/replace/remove.
+// Case sensitivity is fixed at construction, one passed to an algorithm together with a Searcher is ignored.
+template <typename E>
+struct Searcher
+{
+    using value_type = E;
+
+    std::vector<E> needle;
+    Case sensitivity = Case::Sensitive;
+    // Two-Way tables for forward and backward search, only for needles long enough to use them
+    detail::OptionalTwoWay<E> forward;
+    detail::OptionalTwoWay<E> backward;
+
+    explicit Searcher(const E* str, Case case_sensitivity = Case::Sensitive)
+        : Searcher(str, str + strlen(str), case_sensitivity)
+    {}
+    template <typename N = void>
+        requires(!std::is_pointer_v<E>)
+    explicit Searcher(E elem, Case case_sensitivity = Case::Sensitive)
+        : Searcher(&elem, &elem + 1, case_sensitivity)
+    {}
+    template <DataContainer T>
+    explicit Searcher(const T& container, Case case_sensitivity = Case::Sensitive)
+        : Searcher(container.data(), container.data() + container.size(), case_sensitivity)
+    {}
+
+    const E* data() const
+    {
+        return needle.data();
+    }
+
+    size_t size() const
+    {
+        return needle.size();
+    }
+
+    bool uses_two_way() const
+    {
+        if constexpr (detail::two_way_capable<E>)
+            return forward.has_value();
+        return false;
+    }
+
+    detail::Pattern<E> pattern() const
+    {
+        return detail::Pattern<E>{needle.data(), needle.size(), sensitivity, true, &forward, &backward};
+    }
+
+private:
+    Searcher(const E* begin, const E* end, Case case_sensitivity)
+        : needle(begin, end)
+        , sensitivity(case_sensitivity)
+    {
+        if (sensitivity == Case::Insensitive)
+            for (auto& elem : needle)
+                elem = detail::caseless(elem);
+        if constexpr (detail::two_way_capable<E>)
+        {
+            const auto length = needle.size();
+            if (length >= detail::two_way_min_length<E>)
+            {
+                forward.emplace([this](size_t idx) { return needle[idx]; }, length);
+                backward.emplace([this, length](size_t idx) { return needle[length - 1 - idx]; }, length);
+            }
+        }
+    }
+};
+
+template <DataContainer T>
+Searcher(const T& container, Case c = Case::Sensitive) -> Searcher<typename std::remove_reference_t<T>::value_type>;
+template <CStyleArray T>
+Searcher(const T& array, Case c = Case::Sensitive) -> Searcher<typename std::remove_pointer_t<std::decay_t<T>>>;
+
+// Set of single element delimiters preprocessed once and reusable with find_any/rfind_any/count_any/split_any/
+// replace_any/remove_any. Case sensitivity is fixed at construction.
+template <typename E>
+struct AnySearcher
+{
+    using value_type = E;
+
+    Delimiters<E> delimiters;
+    Case sensitivity = Case::Sensitive;
+    std::conditional_t<detail::ByteChar<E>, detail::simd::ByteClass, std::monostate> byte_class{};
+
+    explicit AnySearcher(const E* str, Case case_sensitivity = Case::Sensitive)
+        : delimiters(str, case_sensitivity)
+        , sensitivity(case_sensitivity)
+    {
+        init_byte_class();
+    }
+    template <DataContainer T>
+    explicit AnySearcher(const T& container, Case case_sensitivity = Case::Sensitive)
+        : delimiters(container, case_sensitivity)
+        , sensitivity(case_sensitivity)
+    {
+        init_byte_class();
+    }
+
+    bool contains(E elem) const
+    {
+        return delimiters.contains(elem);
+    }
+
+    detail::AnyPattern<E> pattern() const
+    {
+        return detail::AnyPattern<E>{&delimiters, byte_class};
+    }
+
+private:
+    void init_byte_class()
+    {
+        if constexpr (detail::ByteChar<E>)
+            byte_class = detail::simd::ByteClass(delimiters.delimiters);
+    }
+};
+
+template <DataContainer T>
+AnySearcher(const T& container, Case c = Case::Sensitive)
+    -> AnySearcher<typename std::remove_reference_t<T>::value_type>;
+template <CStyleArray T>
+AnySearcher(const T& array, Case c = Case::Sensitive) -> AnySearcher<typename std::remove_pointer_t<std::decay_t<T>>>;
+
+} // namespace Text
+
+namespace detail {
+
+template <typename T>
+struct is_searcher : std::false_type
+{};
+template <typename E>
+struct is_searcher<Text::Searcher<E>> : std::true_type
+{};
+
+template <typename T>
+struct is_any_searcher : std::false_type
+{};
+template <typename E>
+struct is_any_searcher<Text::AnySearcher<E>> : std::true_type
+{};
+
+// Pattern for a needle wrapped by Delimiter, reuses precomputed data when needle is a Text::Searcher
+template <typename NeedleSrc, typename E>
+Pattern<E> pattern_of(const NeedleSrc& n, const Text::Delimiter<E>& needle, Text::Case sensitivity)
+{
+    if constexpr (is_searcher<NeedleSrc>::value)
+        return n.pattern();
+    else
+        return Pattern<E>{needle.ptr, needle.length, sensitivity};
+}
+
+// Delimiters set built from a needle, returns a reference to already built one for Text::AnySearcher
+template <typename NeedleSrc>
+decltype(auto) delimiters_of(const NeedleSrc& d, Text::Case sensitivity)
+{
+    if constexpr (is_any_searcher<NeedleSrc>::value)
+        return (d.delimiters);
+    else
+        return Text::Delimiters(d, sensitivity);
+}
+
+// Delimiters pattern, reuses tables precomputed by Text::AnySearcher
+template <typename NeedleSrc, typename E>
+AnyPattern<E> any_pattern_of(const NeedleSrc& d, const Text::Delimiters<E>& delimiters)
+{
+    if constexpr (is_any_searcher<NeedleSrc>::value)
+        return d.pattern();
+    else
+    {
+        AnyPattern<E> pattern{&delimiters};
+        if constexpr (ByteChar<E>)
+            pattern.byte_class = simd::ByteClass(delimiters.delimiters);
+        return pattern;
+    }
+}
+
+} // namespace detail
@@ -0,0 +1,682 @@
+#pragma once
+
+#include "common.hpp"
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+#if !defined(TEXT_PROCESSING_DISABLE_SIMD) && (defined(__x86_64__) || defined(_M_X64))
+#define TEXT_PROCESSING_X86_SIMD 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(TEXT_PROCESSING_X86_SIMD) && (defined(__GNUC__) || defined(__clang__))
+#define TEXT_PROCESSING_TARGET(isa) __attribute__((target(isa)))
+#else
+#define TEXT_PROCESSING_TARGET(isa)
+#endif
+
+namespace detail {
+
+template <typename T>
+concept ByteChar = std::is_integral_v<std::remove_cvref_t<T>> && sizeof(T) == 1;
+
+// Case folding is only defined for char and wchar_t (see caseless), other byte types are compared verbatim
+template <ByteChar E>
+constexpr bool folds_case(Text::Case sensitivity)
+{
+    return sensitivity == Text::Case::Insensitive && RegularChar<E>;
+}
+
+namespace simd {
+
+enum class Level
+{
+    Scalar,
+    SSE2,
+    SSSE3,
+    AVX2,
+};
+
+inline Level detect_level()
+{
+#if defined(TEXT_PROCESSING_X86_SIMD)
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return Level::AVX2;
+    if (__builtin_cpu_supports("ssse3"))
+        return Level::SSSE3;
+#elif defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    const auto max_leaf = info[0];
+    __cpuid(info, 1);
+    const bool has_ssse3 = (info[2] & (1 << 9)) != 0;
+    const bool os_saves_ymm = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+    if (max_leaf >= 7)
+    {
+        __cpuidex(info, 7, 0);
+        if (os_saves_ymm && (info[1] & (1 << 5)) != 0)
+            return Level::AVX2;
+    }
+    if (has_ssse3)
+        return Level::SSSE3;
+#endif
+    return Level::SSE2;
+#else
+    return Level::Scalar;
+#endif
+}
+
+inline Level level()
+{
+    static const Level detected = detect_level();
+    return detected;
+}
+
+// Bits that have to be set in text byte before comparing it with (already folded) needle byte.
+// For lowercase letters setting 0x20 maps uppercase variant to the same value, other bytes match exactly.
+inline char fold_mask(uint8_t byte, bool fold)
+{
+    return fold && byte >= 'a' && byte <= 'z' ? 0x20 : 0;
+}
+
+inline bool equal_bytes(const uint8_t* lhs, const uint8_t* rhs, size_t len, bool fold)
+{
+    if (!fold)
+        return std::memcmp(lhs, rhs, len) == 0;
+    for (; len > 0; --len, ++lhs, ++rhs)
+        if (caseless(static_cast<char>(*lhs)) != static_cast<char>(*rhs))
+            return false;
+    return true;
+}
+
+// Every function below expects needle to be already folded (lowercase) when fold is set.
+// Returns pointer to first match fully contained in [first, last) or last if there is none.
+inline const uint8_t* find_bytes_scalar(const uint8_t* first, const uint8_t* last, const uint8_t* needle, size_t len,
+                                        bool fold)
+{
+    if (static_cast<size_t>(last - first) < len)
+        return last;
+    for (const auto* current = first; current + len <= last; ++current)
+        if (equal_bytes(current, needle, len, fold))
+            return current;
+    return last;
+}
+
+#if defined(TEXT_PROCESSING_X86_SIMD)
+TEXT_PROCESSING_TARGET("sse2")
+inline const uint8_t* find_bytes_sse2(const uint8_t* first, const uint8_t* last, const uint8_t* needle, size_t len,
+                                      bool fold)
+{
+    constexpr size_t block_size = 16;
+    const auto first_byte = _mm_set1_epi8(static_cast<char>(needle[0]));
+    const auto last_byte = _mm_set1_epi8(static_cast<char>(needle[len - 1]));
+    const auto first_mask = _mm_set1_epi8(fold_mask(needle[0], fold));
+    const auto last_mask = _mm_set1_epi8(fold_mask(needle[len - 1], fold));
+    const auto* current = first;
+    if (static_cast<size_t>(last - first) >= len + block_size - 1)
+    {
+        const auto* block_end = last - (len - 1) - block_size;
+        for (; current <= block_end; current += block_size)
+        {
+            auto head = _mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(current)), first_mask);
+            auto tail = _mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(current + len - 1)), last_mask);
+            auto mask = static_cast<uint32_t>(_mm_movemask_epi8(
+                _mm_and_si128(_mm_cmpeq_epi8(head, first_byte), _mm_cmpeq_epi8(tail, last_byte))));
+            while (mask != 0)
+            {
+                const auto* candidate = current + std::countr_zero(mask);
+                if (len <= 2 || equal_bytes(candidate + 1, needle + 1, len - 2, fold))
+                    return candidate;
+                mask &= mask - 1;
+            }
+        }
+    }
+    return find_bytes_scalar(current, last, needle, len, fold);
+}
+
+TEXT_PROCESSING_TARGET("avx2")
+inline const uint8_t* find_bytes_avx2(const uint8_t* first, const uint8_t* last, const uint8_t* needle, size_t len,
+                                      bool fold)
+{
+    constexpr size_t block_size = 32;
+    const auto first_byte = _mm256_set1_epi8(static_cast<char>(needle[0]));
+    const auto last_byte = _mm256_set1_epi8(static_cast<char>(needle[len - 1]));
+    const auto first_mask = _mm256_set1_epi8(fold_mask(needle[0], fold));
+    const auto last_mask = _mm256_set1_epi8(fold_mask(needle[len - 1], fold));
+    const auto* current = first;
+    if (static_cast<size_t>(last - first) >= len + block_size - 1)
+    {
+        const auto* block_end = last - (len - 1) - block_size;
+        for (; current <= block_end; current += block_size)
+        {
+            auto head = _mm256_or_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(current)), first_mask);
+            auto tail =
+                _mm256_or_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(current + len - 1)), last_mask);
+            auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+                _mm256_and_si256(_mm256_cmpeq_epi8(head, first_byte), _mm256_cmpeq_epi8(tail, last_byte))));
+            while (mask != 0)
+            {
+                const auto* candidate = current + std::countr_zero(mask);
+                if (len <= 2 || equal_bytes(candidate + 1, needle + 1, len - 2, fold))
+                    return candidate;
+                mask &= mask - 1;
+            }
+        }
+    }
+    return find_bytes_sse2(current, last, needle, len, fold);
+}
+#endif
+
+inline const uint8_t* find_bytes(const uint8_t* first, const uint8_t* last, const uint8_t* needle, size_t len,
+                                 bool fold)
+{
+    if (first >= last || len == 0)
+        return last;
+#if defined(TEXT_PROCESSING_X86_SIMD)
+    if (level() == Level::AVX2)
+        return find_bytes_avx2(first, last, needle, len, fold);
+    return find_bytes_sse2(first, last, needle, len, fold);
+#else
+    return find_bytes_scalar(first, last, needle, len, fold);
+#endif
+}
+
+// Number of bytes in [first, last) equal to (already folded) byte
+inline size_t count_byte_scalar(const uint8_t* first, const uint8_t* last, uint8_t byte, bool fold)
+{
+    const auto mask = static_cast<uint8_t>(fold_mask(byte, fold));
+    size_t cnt = 0;
+    for (; first < last; ++first)
+        cnt += static_cast<uint8_t>(*first | mask) == byte;
+    return cnt;
+}
+
+#if defined(TEXT_PROCESSING_X86_SIMD)
+TEXT_PROCESSING_TARGET("sse2")
+inline size_t count_byte_sse2(const uint8_t* first, const uint8_t* last, uint8_t byte, bool fold)
+{
+    constexpr size_t block_size = 16;
+    const auto needle = _mm_set1_epi8(static_cast<char>(byte));
+    const auto mask = _mm_set1_epi8(fold_mask(byte, fold));
+    size_t cnt = 0;
+    for (; static_cast<size_t>(last - first) >= block_size; first += block_size)
+    {
+        const auto data = _mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(first)), mask);
+        cnt += std::popcount(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(data, needle))));
+    }
+    return cnt + count_byte_scalar(first, last, byte, fold);
+}
+
+TEXT_PROCESSING_TARGET("avx2")
+inline size_t count_byte_avx2(const uint8_t* first, const uint8_t* last, uint8_t byte, bool fold)
+{
+    constexpr size_t block_size = 32;
+    const auto needle = _mm256_set1_epi8(static_cast<char>(byte));
+    const auto mask = _mm256_set1_epi8(fold_mask(byte, fold));
+    size_t cnt = 0;
+    for (; static_cast<size_t>(last - first) >= block_size; first += block_size)
+    {
+        const auto data = _mm256_or_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(first)), mask);
+        cnt += std::popcount(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(data, needle))));
+    }
+    return cnt + count_byte_sse2(first, last, byte, fold);
+}
+#endif
+
+// Returns number of bytes in [first, last) equal to byte, which has to be already folded when fold is set
+inline size_t count_byte(const uint8_t* first, const uint8_t* last, uint8_t byte, bool fold)
+{
+    if (first >= last)
+        return 0;
+#if defined(TEXT_PROCESSING_X86_SIMD)
+    if (level() == Level::AVX2)
+        return count_byte_avx2(first, last, byte, fold);
+    return count_byte_sse2(first, last, byte, fold);
+#else
+    return count_byte_scalar(first, last, byte, fold);
+#endif
+}
+
+// Byte set matched with two nibble lookups (shufti): byte belongs to the set when tables indexed by its low and
+// high nibble share a bit. Every distinct high nibble gets its own bit while there are at most 8 of them,
+// otherwise high nibbles share bits and candidates have to be confirmed against the exact bitmap.
+struct ByteClass
+{
+    std::array<uint8_t, 16> low{};
+    std::array<uint8_t, 16> high{};
+    std::array<uint64_t, 4> members{};
+    bool exact = true;
+
+    ByteClass() = default;
+    explicit ByteClass(const std::array<uint64_t, 4>& bitmap)
+        : members(bitmap)
+    {
+        std::array<int, 16> bucket{};
+        bucket.fill(-1);
+        int buckets = 0;
+        for (size_t hi = 0; hi < 16; ++hi)
+            if (((members[hi / 4] >> (hi % 4 * 16)) & 0xffff) != 0)
+                bucket[hi] = buckets++;
+        exact = buckets <= 8;
+        for (size_t hi = 0; hi < 16; ++hi)
+        {
+            if (bucket[hi] < 0)
+                continue;
+            const auto bit = static_cast<uint8_t>(1 << (bucket[hi] % 8));
+            high[hi] |= bit;
+            for (size_t lo = 0; lo < 16; ++lo)
+                if (contains(static_cast<uint8_t>(hi * 16 + lo)))
+                    low[lo] |= bit;
+        }
+    }
+
+    bool contains(uint8_t byte) const
+    {
+        return ((members[byte / 64] >> (byte % 64)) & 1) != 0;
+    }
+};
+
+inline const uint8_t* find_class_scalar(const uint8_t* first, const uint8_t* last, const ByteClass& cls)
+{
+    for (; first < last; ++first)
+        if (cls.contains(*first))
+            return first;
+    return last;
+}
+
+inline const uint8_t* rfind_class_scalar(const uint8_t* first, const uint8_t* last, const ByteClass& cls)
+{
+    for (auto current = last; current > first;)
+        if (cls.contains(*--current))
+            return current;
+    return last;
+}
+
+// Lowest candidate in a block mask that really belongs to the class, or -1
+inline int first_in_mask(uint32_t mask, const uint8_t* block, const ByteClass& cls)
+{
+    for (; mask != 0; mask &= mask - 1)
+    {
+        const auto idx = std::countr_zero(mask);
+        if (cls.exact || cls.contains(block[idx]))
+            return idx;
+    }
+    return -1;
+}
+
+// Highest candidate in a block mask that really belongs to the class, or -1
+inline int last_in_mask(uint32_t mask, const uint8_t* block, const ByteClass& cls)
+{
+    while (mask != 0)
+    {
+        const auto idx = 31 - std::countl_zero(mask);
+        if (cls.exact || cls.contains(block[idx]))
+            return idx;
+        mask &= ~(uint32_t{1} << idx);
+    }
+    return -1;
+}
+
+inline size_t count_class_scalar(const uint8_t* first, const uint8_t* last, const ByteClass& cls)
+{
+    size_t cnt = 0;
+    for (; first < last; ++first)
+        cnt += cls.contains(*first);
+    return cnt;
+}
+
+// Number of candidates in a block mask that really belong to the class
+inline size_t count_in_mask(uint32_t mask, const uint8_t* block, const ByteClass& cls)
+{
+    if (cls.exact)
+        return static_cast<size_t>(std::popcount(mask));
+    size_t cnt = 0;
+    for (; mask != 0; mask &= mask - 1)
+        cnt += cls.contains(block[std::countr_zero(mask)]);
+    return cnt;
+}
+
+#if defined(TEXT_PROCESSING_X86_SIMD)
+TEXT_PROCESSING_TARGET("ssse3")
+inline uint32_t class_mask_16(const uint8_t* block, __m128i low, __m128i high)
+{
+    const auto nibble = _mm_set1_epi8(0x0f);
+    const auto data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+    const auto lo = _mm_shuffle_epi8(low, _mm_and_si128(data, nibble));
+    const auto hi = _mm_shuffle_epi8(high, _mm_and_si128(_mm_srli_epi16(data, 4), nibble));
+    const auto none = _mm_cmpeq_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128());
+    return ~static_cast<uint32_t>(_mm_movemask_epi8(none)) & 0xffff;
+}
+
+TEXT_PROCESSING_TARGET("ssse3")
+inline const uint8_t* find_class_ssse3(const uint8_t* first, const uint8_t* last, const ByteClass& cls)
+{
+    constexpr size_t block_size = 16;
+    const auto low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cls.low.data()));
+    const auto high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cls.high.data()));
+    for (; static_cast<size_t>(last - first) >= block_size; first += block_size)
+        if (auto idx = first_in_mask(class_mask_16(first, low, high), first, cls); idx >= 0)
+            return first + idx;
+    return find_class_scalar(first, last, cls);
+}
+
+TEXT_PROCESSING_TARGET("ssse3")
+inline const uint8_t* rfind_class_ssse3(const uint8_t* first, const uint8_t* last, const ByteClass& cls)
+{
+    constexpr size_t block_size = 16;
+    const auto low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cls.low.data()));
+    const auto high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cls.high.data()));
+    auto current = last;
+    for (; static_cast<size_t>(current - first) >= block_size;)
+    {
+        current -= block_size;
+        if (auto idx = last_in_mask(class_mask_16(current, low, high), current, cls); idx >= 0)
+            return current + idx;
+    }
+    const auto* found = rfind_class_scalar(first, current, cls);
+    return found == current ? last : found;
+}
+
+TEXT_PROCESSING_TARGET("ssse3")
+inline size_t count_class_ssse3(const uint8_t* first, const uint8_t* last, const ByteClass& cls)
+{
+    constexpr size_t block_size = 16;
+    const auto low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cls.low.data()));
+    const auto high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cls.high.data()));
+    size_t cnt = 0;
+    for (; static_cast<size_t>(last - first) >= block_size; first += block_size)
+        cnt += count_in_mask(class_mask_16(first, low, high), first, cls);
+    return cnt + count_class_scalar(first, last, cls);
+}
+
+TEXT_PROCESSING_TARGET("avx2")
+inline uint32_t class_mask_32(const uint8_t* block, __m256i low, __m256i high)
+{
+    const auto nibble = _mm256_set1_epi8(0x0f);
+    const auto data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+    const auto lo = _mm256_shuffle_epi8(low, _mm256_and_si256(data, nibble));
+    const auto hi = _mm256_shuffle_epi8(high, _mm256_and_si256(_mm256_srli_epi16(data, 4), nibble));
+    const auto none = _mm256_cmpeq_epi8(_mm256_and_si256(lo, hi), _mm256_setzero_si256());
+    return ~static_cast<uint32_t>(_mm256_movemask_epi8(none));
+}
+
+TEXT_PROCESSING_TARGET("avx2")
+inline const uint8_t* find_class_avx2(const uint8_t* first, const uint8_t* last, const ByteClass& cls)
+{
+    constexpr size_t block_size = 32;
+    // pshufb works within 128 bit lanes, so both lanes get the same table
+    const auto low = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(cls.low.data())));
+    const auto high = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(cls.high.data())));
+    for (; static_cast<size_t>(last - first) >= block_size; first += block_size)
+        if (auto idx = first_in_mask(class_mask_32(first, low, high), first, cls); idx >= 0)
+            return first + idx;
+    return find_class_ssse3(first, last, cls);
+}
+
+TEXT_PROCESSING_TARGET("avx2")
+inline const uint8_t* rfind_class_avx2(const uint8_t* first, const uint8_t* last, const ByteClass& cls)
+{
+    constexpr size_t block_size = 32;
+    const auto low = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(cls.low.data())));
+    const auto high = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(cls.high.data())));
+    auto current = last;
+    for (; static_cast<size_t>(current - first) >= block_size;)
+    {
+        current -= block_size;
+        if (auto idx = last_in_mask(class_mask_32(current, low, high), current, cls); idx >= 0)
+            return current + idx;
+    }
+    const auto* found = rfind_class_ssse3(first, current, cls);
+    return found == current ? last : found;
+}
+
+TEXT_PROCESSING_TARGET("avx2")
+inline size_t count_class_avx2(const uint8_t* first, const uint8_t* last, const ByteClass& cls)
+{
+    constexpr size_t block_size = 32;
+    const auto low = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(cls.low.data())));
+    const auto high = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(cls.high.data())));
+    size_t cnt = 0;
+    for (; static_cast<size_t>(last - first) >= block_size; first += block_size)
+        cnt += count_in_mask(class_mask_32(first, low, high), first, cls);
+    return cnt + count_class_ssse3(first, last, cls);
+}
+#endif
+
+// Returns first byte from class in [first, last) or last
+inline const uint8_t* find_class(const uint8_t* first, const uint8_t* last, const ByteClass& cls)
+{
+    if (first >= last)
+        return last;
+#if defined(TEXT_PROCESSING_X86_SIMD)
+    if (level() == Level::AVX2)
+        return find_class_avx2(first, last, cls);
+    if (level() == Level::SSSE3)
+        return find_class_ssse3(first, last, cls);
+#endif
+    return find_class_scalar(first, last, cls);
+}
+
+// Returns last byte from class in [first, last) or last
+inline const uint8_t* rfind_class(const uint8_t* first, const uint8_t* last, const ByteClass& cls)
+{
+    if (first >= last)
+        return last;
+#if defined(TEXT_PROCESSING_X86_SIMD)
+    if (level() == Level::AVX2)
+        return rfind_class_avx2(first, last, cls);
+    if (level() == Level::SSSE3)
+        return rfind_class_ssse3(first, last, cls);
+#endif
+    return rfind_class_scalar(first, last, cls);
+}
+
+// Returns number of bytes from class in [first, last)
+inline size_t count_class(const uint8_t* first, const uint8_t* last, const ByteClass& cls)
+{
+    if (first >= last)
+        return 0;
+#if defined(TEXT_PROCESSING_X86_SIMD)
+    if (level() == Level::AVX2)
+        return count_class_avx2(first, last, cls);
+    if (level() == Level::SSSE3)
+        return count_class_ssse3(first, last, cls);
+#endif
+    return count_class_scalar(first, last, cls);
+}
+
+// Copies bytes of [first, last) not in class to out keeping their order, returns end of copied bytes. Output may
+// start at first (compaction in place) but not after it. Whole vector blocks are written, so out has to have
+// room for last - first bytes.
+inline uint8_t* remove_class_scalar(const uint8_t* first, const uint8_t* last, uint8_t* out, const ByteClass& cls)
+{
+    for (; first < last; ++first)
+    {
+        // Every byte is written, only kept ones advance the output
+        *out = *first;
+        out += !cls.contains(*first);
+    }
+    return out;
+}
+
+#if defined(TEXT_PROCESSING_X86_SIMD)
+// Shuffle moving bytes selected by a 8 bit mask to the front of 8 byte group
+constexpr std::array<uint64_t, 256> compress_shuffles()
+{
+    std::array<uint64_t, 256> shuffles{};
+    for (size_t mask = 0; mask < 256; ++mask)
+    {
+        size_t kept = 0;
+        for (uint64_t idx = 0; idx < 8; ++idx)
+            if ((mask >> idx) & 1)
+                shuffles[mask] |= idx << (8 * kept++);
+    }
+    return shuffles;
+}
+
+inline constexpr auto compress_shuffle = compress_shuffles();
+
+// Blocks without class bytes are stored as a whole, others are compressed in two 8 byte halves. Output never
+// passes the end of a block already loaded, so compaction works in place.
+TEXT_PROCESSING_TARGET("ssse3")
+inline uint8_t* remove_class_ssse3(const uint8_t* first, const uint8_t* last, uint8_t* out, const ByteClass& cls)
+{
+    constexpr size_t block_size = 16;
+    const auto low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cls.low.data()));
+    const auto high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cls.high.data()));
+    for (; static_cast<size_t>(last - first) >= block_size; first += block_size)
+    {
+        const auto data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+        auto removed = class_mask_16(first, low, high);
+        if (!cls.exact)
+            for (auto candidates = removed; candidates != 0; candidates &= candidates - 1)
+                if (const auto idx = std::countr_zero(candidates); !cls.contains(first[idx]))
+                    removed &= ~(uint32_t{1} << idx);
+        if (removed == 0)
+        {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), data);
+            out += block_size;
+            continue;
+        }
+        const auto kept = ~removed & 0xffff;
+        const auto low_shuffle = static_cast<long long>(compress_shuffle[kept & 0xff]);
+        const auto high_shuffle = static_cast<long long>(compress_shuffle[kept >> 8]);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(out), _mm_shuffle_epi8(data, _mm_cvtsi64_si128(low_shuffle)));
+        out += std::popcount(kept & 0xff);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(out),
+                         _mm_shuffle_epi8(_mm_srli_si128(data, 8), _mm_cvtsi64_si128(high_shuffle)));
+        out += std::popcount(kept >> 8);
+    }
+    for (; first < last; ++first)
+    {
+        *out = *first;
+        out += !cls.contains(*first);
+    }
+    return out;
+}
+#endif
+
+// Copies bytes of [first, last) not in class to out (see remove_class_scalar), returns end of copied bytes
+inline uint8_t* remove_class(const uint8_t* first, const uint8_t* last, uint8_t* out, const ByteClass& cls)
+{
+    if (first >= last)
+        return out;
+#if defined(TEXT_PROCESSING_X86_SIMD)
+    if (level() == Level::AVX2 || level() == Level::SSSE3)
+        return remove_class_ssse3(first, last, out, cls);
+#endif
+    return remove_class_scalar(first, last, out, cls);
+}
+
+// Value of eight decimal digits already mapped to 0-9, first digit in the lowest byte (little endian load)
+inline uint32_t eight_digits(uint64_t digits)
+{
+    digits = digits * 10 + (digits >> 8);
+    digits = ((digits & 0x000000FF000000FF) * (100 + (1000000ULL << 32)) +
+              ((digits >> 16) & 0x000000FF000000FF) * (1 + (10000ULL << 32))) >>
+             32;
+    return static_cast<uint32_t>(digits);
+}
+
+// Number of leading digit bytes in a chunk xored with '0' bytes (digits become 0-9, every other byte is >= 10)
+inline size_t leading_digits(uint64_t digits, size_t width)
+{
+    const auto non_digits = (((digits & 0x7F7F7F7F7F7F7F7F) + 0x7676767676767676) | digits) & 0x8080808080808080;
+    return non_digits == 0 ? width : static_cast<size_t>(std::countr_zero(non_digits) / 8);
+}
+
+// Parses leading decimal digits of [first, last), eight (or four for a shorter tail) of them per step (SWAR).
+// Returns end of the digits, value is set when it fits into 64 bits, otherwise overflow is set.
+inline const uint8_t* parse_digits(const uint8_t* first, const uint8_t* last, uint64_t& value, bool& overflow)
+{
+    constexpr uint64_t powers[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000};
+    uint64_t result = 0;
+    bool overflowed = false;
+    // Up to 19 digits always fit, only longer numbers need a (division based) range check
+    size_t parsed = 0;
+    auto accumulate = [&](uint64_t digits_value, size_t count) {
+        parsed += count;
+        if (parsed > 19 && result > (std::numeric_limits<uint64_t>::max() - digits_value) / powers[count])
+            overflowed = true;
+        result = result * powers[count] + digits_value;
+    };
+
+    const auto* current = first;
+    // Fixed size loads only, last few digits (and all of them on big endian targets) are parsed one by one
+    if constexpr (std::endian::native == std::endian::little)
+    {
+        bool more = true;
+        while (more && last - current >= 8)
+        {
+            uint64_t chunk = 0;
+            std::memcpy(&chunk, current, 8);
+            const auto digits = chunk ^ 0x3030303030303030;
+            const auto count = leading_digits(digits, 8);
+            // Leading zero bytes are leading zero digits, so a shorter run is parsed as eight digits as well
+            if (count != 0)
+                accumulate(eight_digits(digits << (8 * (8 - count))), count);
+            current += count;
+            more = count == 8;
+        }
+        if (more && last - current >= 4)
+        {
+            uint32_t chunk = 0;
+            std::memcpy(&chunk, current, 4);
+            const auto digits = static_cast<uint64_t>(chunk ^ 0x30303030) << 32;
+            const auto count = leading_digits(digits >> 32, 4);
+            if (count != 0)
+                accumulate(eight_digits(digits << (8 * (4 - count))), count);
+            current += count;
+            more = count == 4;
+        }
+        if (!more)
+        {
+            value = result;
+            overflow = overflowed;
+            return current;
+        }
+    }
+    for (; current < last && static_cast<uint8_t>(*current - '0') < 10; ++current)
+        accumulate(static_cast<uint8_t>(*current - '0'), 1);
+    value = result;
+    overflow = overflowed;
+    return current;
+}
+
+} // namespace simd
+
+// Vectorized counterpart of are_equal based scan for byte texts with unit step
+template <ByteChar E>
+const E* find_bytes(const E* first, const E* last, const E* needle, size_t len, Text::Case sensitivity)
+{
+    const bool fold = folds_case<E>(sensitivity);
+    const auto* n = reinterpret_cast<const uint8_t*>(needle);
+    // Needles are short in practice, keep a folded copy on stack and fall back to plain scan for longer ones
+    constexpr size_t folded_limit = 256;
+    uint8_t folded[folded_limit];
+    if (fold)
+    {
+        if (len > folded_limit)
+        {
+            for (; first + len <= last; ++first)
+                if (Text::are_equal(first, needle, len, sensitivity))
+                    return first;
+            return last;
+        }
+        for (size_t idx = 0; idx < len; ++idx)
+            folded[idx] = static_cast<uint8_t>(caseless(static_cast<char>(n[idx])));
+        n = folded;
+    }
+    const auto* found = simd::find_bytes(reinterpret_cast<const uint8_t*>(first),
+                                         reinterpret_cast<const uint8_t*>(last), n, len, fold);
+    return reinterpret_cast<const E*>(found);
+}
+
+} // namespace detail
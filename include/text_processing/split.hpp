@@ -1,6 +1,12 @@
 #pragma once
 
 #include "common.hpp"
+#include "searcher.hpp"
+#include "sub.hpp"
+
+#include <iterator>
+#include <optional>
+#include <ranges>
 
 namespace Text {
 
@@ -10,133 +16,588 @@ enum class SplitBehavior
     DropEmpty
 };
 
-template <typename TextSrc, typename DelimSrc>
-    requires CanBeDelimiterOf<DelimSrc, TextSrc>
-auto split(const TextSrc& t, const DelimSrc& d, SplitBehavior beh = SplitBehavior::KeepEmpty, int start = Start,
-           int end = End, int step = Step, Case sensitivity = Case::Sensitive)
+} // namespace Text
+
+namespace detail {
+
+// Value rebuilt on demand that is never copied, so it may safely point into the object owning it
+template <typename T>
+struct LazyCache
 {
-    Text text(t);
-    Delimiter delimiter(d);
-    std::vector<std::basic_string_view<container_type_t<TextSrc>>> results;
+    std::optional<T> value;
 
-    if (text.length == 0 || step <= 0)
-        return results;
-    auto unsigned_step = static_cast<unsigned int>(step);
+    LazyCache() = default;
+    LazyCache(const LazyCache&) noexcept
+    {}
+    LazyCache& operator=(const LazyCache&) noexcept
+    {
+        value.reset();
+        return *this;
+    }
+};
+
+// Matchers used by Splitter and match scans. next() reports the first match on step lattice starting at current
+// that fits into [current, last), prev() the last one on lattice going down from candidate not before first,
+// both return nullptr when there is none. size() is the length of the match returned (zero splits text into
+// chunks). Needles are referenced, single element needles are kept by value.
+template <typename E, typename NeedleSrc>
+struct NeedleMatcher
+{
+    static constexpr bool single = std::same_as<std::remove_cvref_t<NeedleSrc>, E>;
+
+    E elem{};
+    const E* ptr = nullptr;
+    size_t length = 0;
+    Text::Case sensitivity = Text::Case::Sensitive;
+    const NeedleSrc* source = nullptr;
+    LazyCache<Pattern<E>> pattern;
 
-    if (sanitize_index(start, text.length) == End || sanitize_index(end, text.length) == End)
+    NeedleMatcher(const NeedleSrc& n, Text::Case case_sensitivity)
+        : sensitivity(case_sensitivity)
+        , source(&n)
     {
-        results.emplace_back(text.ptr, text.length);
-        return results;
+        Text::Delimiter delimiter(n);
+        length = delimiter.length;
+        if constexpr (single)
+            elem = delimiter.elem;
+        else
+            ptr = delimiter.ptr;
     }
 
-    if (delimiter.length == 0)
+    size_t size() const
     {
-        results.reserve((text.length + unsigned_step - 1) / unsigned_step);
-        for (; start < end; start += step)
-            results.emplace_back(text.ptr + start, std::min(end - start, step));
-        return results;
+        return length;
     }
 
-    auto start_ptr = text.ptr;
-    auto current = start_ptr + start;
-    auto skip_after_match = unsigned_step;
-    while (skip_after_match < delimiter.length)
-        skip_after_match += unsigned_step;
+    const E* next(const E* current, const E* last, Text::Index step)
+    {
+        auto& needle = get();
+        if (step == 1)
+        {
+            const auto* found = needle.find_in(current, last);
+            return found == last ? nullptr : found;
+        }
+        for (; current + length <= last; current += step)
+            if (needle.matches(current))
+                return current;
+        return nullptr;
+    }
 
-    while (current + delimiter.length <= text.ptr + end)
+    const E* prev(const E* first, const E* candidate, Text::Index step)
     {
-        if (!are_equal(current, delimiter.ptr, delimiter.length, sensitivity))
+        auto& needle = get();
+        if (step == 1)
         {
-            current += step;
-            continue;
+            const auto* found = needle.rfind_in(first, candidate + length);
+            return found == candidate + length ? nullptr : found;
+        }
+        for (;; candidate -= step)
+        {
+            if (needle.matches(candidate))
+                return candidate;
+            if (candidate - first < step)
+                return nullptr;
         }
-        if (start_ptr != current || beh == SplitBehavior::KeepEmpty)
-            results.emplace_back(start_ptr, current - start_ptr);
-        start_ptr = current + delimiter.length;
-        current += skip_after_match;
     }
-    current = std::min(current, text.ptr + end);
-    start_ptr = std::min(start_ptr, text.ptr + end);
-    if (start_ptr != current || beh == SplitBehavior::KeepEmpty)
-        results.emplace_back(start_ptr, text.ptr + text.length - start_ptr);
-    return results;
-}
 
-template <typename TextSrc, typename DelimSrc>
-    requires CanBeDelimiterOf<DelimSrc, TextSrc>
-auto split_any(const TextSrc& t, const DelimSrc& d, SplitBehavior beh = SplitBehavior::KeepEmpty, int start = Start,
-               int end = End, int step = Step, Case sensitivity = Case::Sensitive)
+private:
+    Pattern<E>& get()
+    {
+        if (!pattern.value)
+        {
+            if constexpr (is_searcher<NeedleSrc>::value)
+                pattern.value.emplace(source->pattern());
+            else
+                pattern.value.emplace(Pattern<E>{single ? &elem : ptr, length, sensitivity});
+        }
+        return *pattern.value;
+    }
+};
+
+template <typename E, typename NeedleSrc>
+struct AnyMatcher
 {
-    Text text(t);
-    Delimiters delimiters(d, sensitivity);
-    std::vector<std::basic_string_view<container_type_t<TextSrc>>> results;
+    using Storage = std::conditional_t<is_any_searcher<NeedleSrc>::value, const NeedleSrc*, Text::Delimiters<E>>;
 
-    if (text.length == 0 || step <= 0)
-        return results;
+    Storage delimiters;
+    LazyCache<AnyPattern<E>> pattern;
+
+    AnyMatcher(const NeedleSrc& d, Text::Case sensitivity)
+        : delimiters(init(d, sensitivity))
+    {}
 
-    if (sanitize_index(start, text.length) == End || sanitize_index(end, text.length) == End)
+    static Storage init(const NeedleSrc& d, Text::Case sensitivity)
     {
-        results.emplace_back(text.ptr, text.length);
-        return results;
+        if constexpr (is_any_searcher<NeedleSrc>::value)
+            return &d;
+        else
+            return Text::Delimiters<E>(d, sensitivity);
     }
 
-    auto start_ptr = text.ptr;
-    auto current = start_ptr + start;
+    size_t size() const
+    {
+        return 1;
+    }
 
-    while (current < text.ptr + end)
+    const E* next(const E* current, const E* last, Text::Index step)
     {
-        if (!delimiters.contains(*current, sensitivity))
+        const auto& any = get();
+        if (step == 1)
         {
-            current += step;
-            continue;
+            const auto* found = any.find_in(current, last);
+            return found == last ? nullptr : found;
+        }
+        for (; current < last; current += step)
+            if (any.contains(*current))
+                return current;
+        return nullptr;
+    }
+
+    const E* prev(const E* first, const E* candidate, Text::Index step)
+    {
+        const auto& any = get();
+        if (step == 1)
+        {
+            const auto* found = any.rfind_in(first, candidate + 1);
+            return found == candidate + 1 ? nullptr : found;
+        }
+        for (;; candidate -= step)
+        {
+            if (any.contains(*candidate))
+                return candidate;
+            if (candidate - first < step)
+                return nullptr;
         }
-        if (start_ptr != current || beh == SplitBehavior::KeepEmpty)
-            results.emplace_back(start_ptr, current - start_ptr);
-        start_ptr = current + 1;
-        current += step;
     }
-    current = std::min(current, text.ptr + end);
-    start_ptr = std::min(start_ptr, text.ptr + end);
-    if (start_ptr != current || beh == SplitBehavior::KeepEmpty)
-        results.emplace_back(start_ptr, text.ptr + text.length - start_ptr);
+
+    // Copies elements of [first, last) that are not matches to out (see AnyPattern::remove_into)
+    E* remove_into(const E* first, const E* last, E* out)
+    {
+        return get().remove_into(first, last, out);
+    }
+
+private:
+    const AnyPattern<E>& get()
+    {
+        if (!pattern.value)
+        {
+            if constexpr (is_any_searcher<NeedleSrc>::value)
+                pattern.value.emplace(delimiters->pattern());
+            else
+                pattern.value.emplace(any_pattern_of(delimiters, delimiters));
+        }
+        return *pattern.value;
+    }
+};
+
+template <typename E, typename Predicate>
+struct PredicateMatcher
+{
+    Predicate pred;
+
+    size_t size() const
+    {
+        return 1;
+    }
+
+    const E* next(const E* current, const E* last, Text::Index step)
+    {
+        for (; current < last; current += step)
+            if (pred(*current))
+                return current;
+        return nullptr;
+    }
+
+    const E* prev(const E* first, const E* candidate, Text::Index step)
+    {
+        for (;; candidate -= step)
+        {
+            if (pred(*candidate))
+                return candidate;
+            if (candidate - first < step)
+                return nullptr;
+        }
+    }
+    E* remove_into(const E* first, const E* last, E* out)
+    {
+        for (; first < last; ++first)
+        {
+            *out = *first;
+            out += !pred(*first);
+        }
+        return out;
+    }
+};
+
+// Position of a split in progress. Fragment is valid unless stage is Done.
+template <typename E>
+struct SplitCursor
+{
+    enum class Stage
+    {
+        Chunks,
+        Matching,
+        Last,
+        Done,
+    };
+
+    Stage stage = Stage::Done;
+    const E* start_ptr = nullptr;
+    const E* current = nullptr;
+    std::basic_string_view<E> fragment;
+
+    bool operator==(const SplitCursor& other) const
+    {
+        if (stage == Stage::Done || other.stage == Stage::Done)
+            return stage == other.stage;
+        return stage == other.stage && current == other.current && fragment.data() == other.fragment.data() &&
+               fragment.size() == other.fragment.size();
+    }
+};
+
+// Split state machine shared by eager split functions and lazy split views.
+// Text before start is part of the first fragment and text after end is part of the last one.
+template <typename E, typename Matcher>
+class Splitter
+{
+public:
+    using Cursor = SplitCursor<E>;
+    using Stage = typename Cursor::Stage;
+
+    Splitter(const E* ptr, size_t length, Matcher matcher, Text::SplitBehavior beh, Text::Index start,
+             Text::Index end, Text::Index step)
+        : matcher_(std::move(matcher))
+        , ptr_(ptr)
+        , length_(length)
+        , beh_(beh)
+        , start_(start)
+        , end_(end)
+        , step_(step)
+    {
+        if (length_ == 0 || step_ <= 0)
+            return;
+        valid_ = Text::sanitize_index(start_, length_) != Text::End && Text::sanitize_index(end_, length_) != Text::End;
+    }
+
+    Cursor begin()
+    {
+        Cursor cursor;
+        if (length_ == 0 || step_ <= 0)
+            return cursor;
+        if (!valid_)
+        {
+            cursor.stage = Stage::Last;
+            cursor.fragment = {ptr_, length_};
+            return cursor;
+        }
+        cursor.stage = matcher_.size() == 0 ? Stage::Chunks : Stage::Matching;
+        cursor.start_ptr = ptr_;
+        cursor.current = ptr_ + start_;
+        advance(cursor);
+        return cursor;
+    }
+
+    void advance(Cursor& cursor)
+    {
+        const auto* last = ptr_ + end_;
+        switch (cursor.stage)
+        {
+        case Stage::Chunks:
+            if (cursor.current >= last)
+            {
+                cursor.stage = Stage::Done;
+                return;
+            }
+            cursor.fragment = {cursor.current, std::min(static_cast<size_t>(last - cursor.current),
+                                                        static_cast<size_t>(step_))};
+            cursor.current += step_;
+            return;
+        case Stage::Matching:
+            while (const auto* found = matcher_.next(cursor.current, last, step_))
+            {
+                const auto* fragment_start = cursor.start_ptr;
+                cursor.start_ptr = found + matcher_.size();
+                cursor.current = found + skip_after(matcher_.size());
+                if (fragment_start != found || beh_ == Text::SplitBehavior::KeepEmpty)
+                {
+                    cursor.fragment = {fragment_start, static_cast<size_t>(found - fragment_start)};
+                    return;
+                }
+            }
+            cursor.stage = Stage::Last;
+            cursor.fragment = {cursor.start_ptr, static_cast<size_t>(ptr_ + length_ - cursor.start_ptr)};
+            if (cursor.fragment.empty() && beh_ == Text::SplitBehavior::DropEmpty)
+                cursor.stage = Stage::Done;
+            return;
+        case Stage::Last:
+        case Stage::Done:
+            cursor.stage = Stage::Done;
+            return;
+        }
+    }
+
+    // Upper bound of fragments count when it is known without scanning the text
+    size_t chunks_count() const
+    {
+        if (!valid_ || matcher_.size() != 0 || end_ <= start_)
+            return 0;
+        return static_cast<size_t>((end_ - start_ - 1) / step_ + 1);
+    }
+
+private:
+    // Smallest multiple of step not shorter than a match, next match is looked for on the same lattice after it
+    size_t skip_after(size_t match_length) const
+    {
+        const auto step = static_cast<size_t>(step_);
+        return match_length <= step ? step : (match_length + step - 1) / step * step;
+    }
+
+    Matcher matcher_;
+    const E* ptr_;
+    size_t length_;
+    Text::SplitBehavior beh_;
+    Text::Index start_;
+    Text::Index end_;
+    Text::Index step_;
+    bool valid_ = false;
+};
+
+template <typename E, typename Matcher, typename Alloc = std::allocator<std::basic_string_view<E>>>
+auto split_all(Splitter<E, Matcher> splitter, const Alloc& alloc = Alloc())
+{
+    std::vector<std::basic_string_view<E>, rebind_alloc<std::basic_string_view<E>, Alloc>> results(alloc);
+    results.reserve(splitter.chunks_count());
+    for (auto cursor = splitter.begin(); cursor.stage != SplitCursor<E>::Stage::Done; splitter.advance(cursor))
+        results.push_back(cursor.fragment);
     return results;
 }
 
+} // namespace detail
+
+namespace Text {
+
+// Lazy split result. Fragments are computed while iterating, the view does not allocate. End iterator has
+// the same type as begin, so results may be passed to algorithms and containers expecting iterator pairs.
+// Text and needle have to outlive the view, single element needles and predicates are stored in it.
+template <typename E, typename Matcher>
+class SplitView : public std::ranges::view_interface<SplitView<E, Matcher>>
+{
+public:
+    class iterator
+    {
+    public:
+        using value_type = std::basic_string_view<E>;
+        using difference_type = std::ptrdiff_t;
+        using iterator_concept = std::forward_iterator_tag;
+
+        iterator() = default;
+        iterator(detail::Splitter<E, Matcher>* splitter, detail::SplitCursor<E> cursor)
+            : splitter_(splitter)
+            , cursor_(cursor)
+        {}
+
+        value_type operator*() const
+        {
+            return cursor_.fragment;
+        }
+
+        iterator& operator++()
+        {
+            splitter_->advance(cursor_);
+            return *this;
+        }
+
+        iterator operator++(int)
+        {
+            auto copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        bool operator==(const iterator& other) const
+        {
+            return cursor_ == other.cursor_;
+        }
+
+    private:
+        detail::Splitter<E, Matcher>* splitter_ = nullptr;
+        detail::SplitCursor<E> cursor_;
+    };
+
+    explicit SplitView(detail::Splitter<E, Matcher> splitter)
+        : splitter_(std::move(splitter))
+    {}
+
+    iterator begin()
+    {
+        return iterator(&splitter_, splitter_.begin());
+    }
+
+    iterator end()
+    {
+        return iterator(&splitter_, {});
+    }
+
+private:
+    detail::Splitter<E, Matcher> splitter_;
+};
+
+template <typename TextSrc, typename DelimSrc>
+    requires CanBeDelimiterOf<DelimSrc, TextSrc>
+auto split_view(const TextSrc& t, const DelimSrc& d, SplitBehavior beh = SplitBehavior::KeepEmpty,
+                Index start = Start, Index end = End, Index step = Step, Case sensitivity = Case::Sensitive)
+{
+    using E = container_type_t<TextSrc>;
+    using Matcher = detail::NeedleMatcher<E, DelimSrc>;
+    Text text(t);
+    return SplitView<E, Matcher>(detail::Splitter<E, Matcher>(text.ptr, text.length, Matcher(d, sensitivity), beh,
+                                                              start, end, step));
+}
+
+template <typename TextSrc, typename DelimSrc>
+    requires CanBeDelimiterOf<DelimSrc, TextSrc>
+auto split_any_view(const TextSrc& t, const DelimSrc& d, SplitBehavior beh = SplitBehavior::KeepEmpty,
+                    Index start = Start, Index end = End, Index step = Step, Case sensitivity = Case::Sensitive)
+{
+    using E = container_type_t<TextSrc>;
+    using Matcher = detail::AnyMatcher<E, DelimSrc>;
+    Text text(t);
+    return SplitView<E, Matcher>(detail::Splitter<E, Matcher>(text.ptr, text.length, Matcher(d, sensitivity), beh,
+                                                              start, end, step));
+}
+
 template <typename TextSrc, typename Predicate>
-auto split_if(const TextSrc& t, Predicate pred, SplitBehavior beh = SplitBehavior::KeepEmpty, int start = Start,
-              int end = End, int step = Step)
+auto split_if_view(const TextSrc& t, Predicate pred, SplitBehavior beh = SplitBehavior::KeepEmpty,
+                   Index start = Start, Index end = End, Index step = Step)
 {
+    using E = container_type_t<TextSrc>;
+    using Matcher = detail::PredicateMatcher<E, Predicate>;
     Text text(t);
-    std::vector<std::basic_string_view<container_type_t<TextSrc>>> results;
+    return SplitView<E, Matcher>(
+        detail::Splitter<E, Matcher>(text.ptr, text.length, Matcher{std::move(pred)}, beh, start, end, step));
+}
 
-    if (text.length == 0 || step <= 0)
-        return results;
+// Overloads taking std::allocator_arg and an allocator (e.g. std::pmr::polymorphic_allocator over a per request
+// arena) build the result vector with it, other overloads use std::allocator
+template <typename Alloc, typename TextSrc, typename DelimSrc>
+    requires CanBeDelimiterOf<DelimSrc, TextSrc>
+auto split(std::allocator_arg_t, const Alloc& alloc, const TextSrc& t, const DelimSrc& d,
+           SplitBehavior beh = SplitBehavior::KeepEmpty, Index start = Start, Index end = End, Index step = Step,
+           Case sensitivity = Case::Sensitive)
+{
+    using E = container_type_t<TextSrc>;
+    using Matcher = detail::NeedleMatcher<E, DelimSrc>;
+    Text text(t);
+    return detail::split_all(
+        detail::Splitter<E, Matcher>(text.ptr, text.length, Matcher(d, sensitivity), beh, start, end, step), alloc);
+}
 
-    if (sanitize_index(start, text.length) == End || sanitize_index(end, text.length) == End)
+template <typename TextSrc, typename DelimSrc>
+    requires CanBeDelimiterOf<DelimSrc, TextSrc>
+auto split(const TextSrc& t, const DelimSrc& d, SplitBehavior beh = SplitBehavior::KeepEmpty, Index start = Start,
+           Index end = End, Index step = Step, Case sensitivity = Case::Sensitive)
+{
+    return split(std::allocator_arg, std::allocator<std::basic_string_view<container_type_t<TextSrc>>>(), t, d, beh,
+                 start, end, step, sensitivity);
+}
+
+// Fragments of a strided view are strided views into the same text, they are the same as split of a copy of
+// viewed elements would give
+template <typename Alloc, typename E, typename DelimSrc>
+    requires CanBeDelimiterOf<DelimSrc, StridedView<E>>
+auto split(std::allocator_arg_t, const Alloc& alloc, const StridedView<E>& t, const DelimSrc& d,
+           SplitBehavior beh = SplitBehavior::KeepEmpty, Index start = Start, Index end = End, Index step = Step,
+           Case sensitivity = Case::Sensitive)
+{
+    std::vector<StridedView<E>, detail::rebind_alloc<StridedView<E>, Alloc>> results(alloc);
+    const auto length = static_cast<Index>(t.size());
+    if (length == 0 || step <= 0)
+        return results;
+    if (sanitize_index(start, t.size()) == End || sanitize_index(end, t.size()) == End)
     {
-        results.emplace_back(text.ptr, text.length);
+        results.push_back(t);
         return results;
     }
 
-    auto start_ptr = text.ptr;
-    auto current = start_ptr + start;
+    auto fragment = [&t](Index from, Index to) {
+        return t.subview(static_cast<size_t>(from), static_cast<size_t>(to - from));
+    };
+    Delimiter needle(d);
+    const auto match_length = static_cast<Index>(needle.length);
+    if (match_length == 0)
+    {
+        for (auto pos = start; pos < end; pos += step)
+            results.push_back(fragment(pos, std::min(end, pos + step)));
+        return results;
+    }
 
-    while (current < text.ptr + end)
+    // Next match is looked for on the same lattice, after the smallest multiple of step not shorter than a match
+    const auto skip = match_length <= step ? step : (match_length + step - 1) / step * step;
+    auto pattern = detail::pattern_of(d, needle, sensitivity);
+    Index fragment_start = 0;
+    for (auto pos = start; pos + match_length <= end;)
     {
-        if (!pred(*current))
+        if (!pattern.matches_at(t.begin() + pos))
         {
-            current += step;
+            pos += step;
             continue;
         }
-        if (start_ptr != current || beh == SplitBehavior::KeepEmpty)
-            results.emplace_back(start_ptr, current - start_ptr);
-        start_ptr = current + 1;
-        current += step;
+        if (pos != fragment_start || beh == SplitBehavior::KeepEmpty)
+            results.push_back(fragment(fragment_start, pos));
+        fragment_start = pos + match_length;
+        pos += skip;
     }
-    current = std::min(current, text.ptr + end);
-    start_ptr = std::min(start_ptr, text.ptr + end);
-    if (start_ptr != current || beh == SplitBehavior::KeepEmpty)
-        results.emplace_back(start_ptr, text.ptr + text.length - start_ptr);
+    if (fragment_start != length || beh == SplitBehavior::KeepEmpty)
+        results.push_back(fragment(fragment_start, length));
     return results;
 }
+
+template <typename E, typename DelimSrc>
+    requires CanBeDelimiterOf<DelimSrc, StridedView<E>>
+auto split(const StridedView<E>& t, const DelimSrc& d, SplitBehavior beh = SplitBehavior::KeepEmpty,
+           Index start = Start, Index end = End, Index step = Step, Case sensitivity = Case::Sensitive)
+{
+    return split(std::allocator_arg, std::allocator<StridedView<E>>(), t, d, beh, start, end, step, sensitivity);
+}
+
+template <typename Alloc, typename TextSrc, typename DelimSrc>
+    requires CanBeDelimiterOf<DelimSrc, TextSrc>
+auto split_any(std::allocator_arg_t, const Alloc& alloc, const TextSrc& t, const DelimSrc& d,
+               SplitBehavior beh = SplitBehavior::KeepEmpty, Index start = Start, Index end = End, Index step = Step,
+               Case sensitivity = Case::Sensitive)
+{
+    using E = container_type_t<TextSrc>;
+    using Matcher = detail::AnyMatcher<E, DelimSrc>;
+    Text text(t);
+    return detail::split_all(
+        detail::Splitter<E, Matcher>(text.ptr, text.length, Matcher(d, sensitivity), beh, start, end, step), alloc);
+}
+
+template <typename TextSrc, typename DelimSrc>
+    requires CanBeDelimiterOf<DelimSrc, TextSrc>
+auto split_any(const TextSrc& t, const DelimSrc& d, SplitBehavior beh = SplitBehavior::KeepEmpty,
+               Index start = Start, Index end = End, Index step = Step, Case sensitivity = Case::Sensitive)
+{
+    return split_any(std::allocator_arg, std::allocator<std::basic_string_view<container_type_t<TextSrc>>>(), t, d,
+                     beh, start, end, step, sensitivity);
+}
+
+template <typename Alloc, typename TextSrc, typename Predicate>
+auto split_if(std::allocator_arg_t, const Alloc& alloc, const TextSrc& t, Predicate pred,
+              SplitBehavior beh = SplitBehavior::KeepEmpty, Index start = Start, Index end = End, Index step = Step)
+{
+    using E = container_type_t<TextSrc>;
+    using Matcher = detail::PredicateMatcher<E, Predicate>;
+    Text text(t);
+    return detail::split_all(
+        detail::Splitter<E, Matcher>(text.ptr, text.length, Matcher{std::move(pred)}, beh, start, end, step), alloc);
+}
+
+template <typename TextSrc, typename Predicate>
+auto split_if(const TextSrc& t, Predicate pred, SplitBehavior beh = SplitBehavior::KeepEmpty, Index start = Start,
+              Index end = End, Index step = Step)
+{
+    return split_if(std::allocator_arg, std::allocator<std::basic_string_view<container_type_t<TextSrc>>>(), t,
+                    std::move(pred), beh, start, end, step);
+}
 } // namespace Text
@@ -0,0 +1,232 @@
+#pragma once
+
+#include "common.hpp"
+#include "split.hpp"
+
+#include <cerrno>
+#include <istream>
+#include <iterator>
+#include <optional>
+#include <system_error>
+#include <vector>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace detail {
+
+template <typename E>
+struct IstreamSource
+{
+    std::basic_istream<E>* stream;
+
+    size_t read(E* dest, size_t count)
+    {
+        stream->read(dest, static_cast<std::streamsize>(count));
+        return static_cast<size_t>(stream->gcount());
+    }
+};
+
+struct FdSource
+{
+    int fd;
+
+    size_t read(char* dest, size_t count)
+    {
+        for (;;)
+        {
+#if defined(_WIN32)
+            const auto got = ::_read(fd, dest, static_cast<unsigned>(std::min<size_t>(count, 1u << 30)));
+#else
+            const auto got = ::read(fd, dest, count);
+#endif
+            if (got >= 0)
+                return static_cast<size_t>(got);
+            if (errno != EINTR)
+                throw std::system_error(errno, std::generic_category(), "read");
+        }
+    }
+};
+
+} // namespace detail
+
+namespace Text {
+
+// Default number of elements read from input at once
+constexpr size_t StreamChunkSize = size_t{64} << 10;
+
+// Splits input read in chunks from a stream or file descriptor, memory use is bound by chunk size and the
+// longest record. Records follow split semantics (no start/end/step, input size is not known) and are valid
+// until the next advance. Delimiter spanning two chunks is found as unscanned tail of a chunk is carried over.
+// Delimiter has to outlive the splitter, single element delimiters are stored in it.
+template <typename E, typename Matcher, typename Source>
+class StreamSplitter
+{
+public:
+    class iterator
+    {
+    public:
+        using value_type = std::basic_string_view<E>;
+        using difference_type = std::ptrdiff_t;
+        using iterator_concept = std::input_iterator_tag;
+
+        iterator() = default;
+        explicit iterator(StreamSplitter* splitter)
+            : splitter_(splitter)
+        {
+            ++*this;
+        }
+
+        value_type operator*() const
+        {
+            return *record_;
+        }
+
+        iterator& operator++()
+        {
+            record_ = splitter_->next();
+            return *this;
+        }
+
+        void operator++(int)
+        {
+            ++*this;
+        }
+
+        bool operator==(std::default_sentinel_t) const
+        {
+            return !record_;
+        }
+
+    private:
+        StreamSplitter* splitter_ = nullptr;
+        std::optional<value_type> record_;
+    };
+
+    StreamSplitter(Source source, Matcher matcher, SplitBehavior beh, size_t chunk_size)
+        : source_(std::move(source))
+        , matcher_(std::move(matcher))
+        , beh_(beh)
+        , buffer_(std::max(chunk_size, matcher_.size() + 1))
+    {}
+
+    // Next record or nullopt when input is exhausted
+    std::optional<std::basic_string_view<E>> next()
+    {
+        while (!done_)
+        {
+            const auto* first = buffer_.data();
+            if (matcher_.size() == 0 && begin_ < filled_)
+                return std::basic_string_view<E>(first + begin_++, 1);
+            if (const auto* found = matcher_.size() == 0 ? nullptr
+                                                         : matcher_.next(first + scan_, first + filled_, 1))
+            {
+                const auto record_begin = begin_;
+                const auto record_end = static_cast<size_t>(found - first);
+                begin_ = scan_ = record_end + matcher_.size();
+                if (record_end != record_begin || beh_ == SplitBehavior::KeepEmpty)
+                    return std::basic_string_view<E>(first + record_begin, record_end - record_begin);
+                continue;
+            }
+            if (eof_)
+            {
+                done_ = true;
+                // Like split, empty input has no records
+                if (matcher_.size() == 0 || !has_input_ || (begin_ == filled_ && beh_ == SplitBehavior::DropEmpty))
+                    return std::nullopt;
+                return std::basic_string_view<E>(first + begin_, filled_ - begin_);
+            }
+            // Last size - 1 elements may be a beginning of a delimiter completed by the next chunk
+            const auto carry = matcher_.size() == 0 ? 0 : std::min(filled_, matcher_.size() - 1);
+            scan_ = std::max(begin_, filled_ - carry);
+            refill();
+        }
+        return std::nullopt;
+    }
+
+    iterator begin()
+    {
+        return iterator(this);
+    }
+
+    std::default_sentinel_t end() const
+    {
+        return {};
+    }
+
+private:
+    void refill()
+    {
+        if (begin_ != 0)
+        {
+            std::char_traits<E>::move(buffer_.data(), buffer_.data() + begin_, filled_ - begin_);
+            filled_ -= begin_;
+            scan_ -= begin_;
+            begin_ = 0;
+        }
+        // Record longer than a chunk, buffer grows to keep it in one piece
+        if (filled_ == buffer_.size())
+            buffer_.resize(buffer_.size() * 2);
+        const auto got = source_.read(buffer_.data() + filled_, buffer_.size() - filled_);
+        filled_ += got;
+        eof_ = got == 0;
+        has_input_ = has_input_ || got != 0;
+    }
+
+    Source source_;
+    Matcher matcher_;
+    SplitBehavior beh_;
+    std::vector<E> buffer_;
+    size_t begin_ = 0;
+    size_t scan_ = 0;
+    size_t filled_ = 0;
+    bool eof_ = false;
+    bool has_input_ = false;
+    bool done_ = false;
+};
+
+template <typename E, typename DelimSrc>
+    requires std::same_as<container_type_t<DelimSrc>, E>
+auto split_stream(std::basic_istream<E>& input, const DelimSrc& d, SplitBehavior beh = SplitBehavior::KeepEmpty,
+                  Case sensitivity = Case::Sensitive, size_t chunk_size = StreamChunkSize)
+{
+    using Matcher = detail::NeedleMatcher<E, DelimSrc>;
+    return StreamSplitter<E, Matcher, detail::IstreamSource<E>>(detail::IstreamSource<E>{&input},
+                                                                 Matcher(d, sensitivity), beh, chunk_size);
+}
+
+template <typename E, typename DelimSrc>
+    requires std::same_as<container_type_t<DelimSrc>, E>
+auto split_any_stream(std::basic_istream<E>& input, const DelimSrc& d, SplitBehavior beh = SplitBehavior::KeepEmpty,
+                      Case sensitivity = Case::Sensitive, size_t chunk_size = StreamChunkSize)
+{
+    using Matcher = detail::AnyMatcher<E, DelimSrc>;
+    return StreamSplitter<E, Matcher, detail::IstreamSource<E>>(detail::IstreamSource<E>{&input},
+                                                                 Matcher(d, sensitivity), beh, chunk_size);
+}
+
+// File descriptor is read until end of input, it is not closed. Read errors throw std::system_error.
+template <typename DelimSrc>
+    requires std::same_as<container_type_t<DelimSrc>, char>
+auto split_stream(int fd, const DelimSrc& d, SplitBehavior beh = SplitBehavior::KeepEmpty,
+                  Case sensitivity = Case::Sensitive, size_t chunk_size = StreamChunkSize)
+{
+    using Matcher = detail::NeedleMatcher<char, DelimSrc>;
+    return StreamSplitter<char, Matcher, detail::FdSource>(detail::FdSource{fd}, Matcher(d, sensitivity), beh,
+                                                           chunk_size);
+}
+
+template <typename DelimSrc>
+    requires std::same_as<container_type_t<DelimSrc>, char>
+auto split_any_stream(int fd, const DelimSrc& d, SplitBehavior beh = SplitBehavior::KeepEmpty,
+                      Case sensitivity = Case::Sensitive, size_t chunk_size = StreamChunkSize)
+{
+    using Matcher = detail::AnyMatcher<char, DelimSrc>;
+    return StreamSplitter<char, Matcher, detail::FdSource>(detail::FdSource{fd}, Matcher(d, sensitivity), beh,
+                                                           chunk_size);
+}
+
+} // namespace Text
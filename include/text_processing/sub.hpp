@@ -2,48 +2,216 @@
 
 #include "common.hpp"
 
+#include <compare>
+#include <iterator>
+#include <ranges>
+
 namespace Text {
 
+// Elements of a text taken with a fixed stride (negative one walks backwards), e.g. one column of fixed width
+// records. The view does not copy elements, so the text has to outlive it. Positions used by algorithms taking
+// a strided view are indices into the view.
+template <typename E>
+class StridedView : public std::ranges::view_interface<StridedView<E>>
+{
+public:
+    using value_type = E;
+
+    class iterator
+    {
+    public:
+        using value_type = E;
+        using difference_type = std::ptrdiff_t;
+        using iterator_concept = std::random_access_iterator_tag;
+        using iterator_category = std::random_access_iterator_tag;
+
+        iterator() = default;
+        iterator(const E* first, Index stride, difference_type pos)
+            : first_(first)
+            , stride_(stride)
+            , pos_(pos)
+        {}
+
+        const E& operator*() const
+        {
+            return first_[pos_ * stride_];
+        }
+
+        const E& operator[](difference_type offset) const
+        {
+            return first_[(pos_ + offset) * stride_];
+        }
+
+        iterator& operator++()
+        {
+            ++pos_;
+            return *this;
+        }
+
+        iterator operator++(int)
+        {
+            auto copy = *this;
+            ++pos_;
+            return copy;
+        }
+
+        iterator& operator--()
+        {
+            --pos_;
+            return *this;
+        }
+
+        iterator operator--(int)
+        {
+            auto copy = *this;
+            --pos_;
+            return copy;
+        }
+
+        iterator& operator+=(difference_type offset)
+        {
+            pos_ += offset;
+            return *this;
+        }
+
+        iterator& operator-=(difference_type offset)
+        {
+            pos_ -= offset;
+            return *this;
+        }
+
+        friend iterator operator+(iterator it, difference_type offset)
+        {
+            return it += offset;
+        }
+
+        friend iterator operator+(difference_type offset, iterator it)
+        {
+            return it += offset;
+        }
+
+        friend iterator operator-(iterator it, difference_type offset)
+        {
+            return it -= offset;
+        }
+
+        friend difference_type operator-(const iterator& lhs, const iterator& rhs)
+        {
+            return lhs.pos_ - rhs.pos_;
+        }
+
+        bool operator==(const iterator& other) const
+        {
+            return pos_ == other.pos_;
+        }
+
+        auto operator<=>(const iterator& other) const
+        {
+            return pos_ <=> other.pos_;
+        }
+
+    private:
+        // Element at position pos is first_[pos * stride_], so no pointer outside the text is ever formed
+        const E* first_ = nullptr;
+        Index stride_ = 1;
+        difference_type pos_ = 0;
+    };
+
+    StridedView() = default;
+    StridedView(const E* first, size_t size, Index stride)
+        : first_(first)
+        , size_(size)
+        , stride_(stride)
+    {}
+
+    iterator begin() const
+    {
+        return iterator(first_, stride_, 0);
+    }
+
+    iterator end() const
+    {
+        return iterator(first_, stride_, static_cast<std::ptrdiff_t>(size_));
+    }
+
+    size_t size() const
+    {
+        return size_;
+    }
+
+    Index stride() const
+    {
+        return stride_;
+    }
+
+    // Elements are adjacent and in text order, so view() may be used instead
+    bool contiguous() const
+    {
+        return stride_ == 1 || size_ <= 1;
+    }
+
+    std::basic_string_view<E> view() const
+    {
+        return {first_, size_};
+    }
+
+    // Elements [pos, pos + count) of the view
+    StridedView subview(size_t pos, size_t count) const
+    {
+        if (count == 0)
+            return {};
+        return StridedView(first_ + static_cast<Index>(pos) * stride_, count, stride_);
+    }
+
+private:
+    const E* first_ = nullptr;
+    size_t size_ = 0;
+    Index stride_ = 1;
+};
+
+template <typename E>
+using strided_view = StridedView<E>;
+
 template <typename T, typename E = container_type_t<T>>
-auto left_view(const T& text, int length)
+auto left_view(const T& text, Index length)
 {
     Text t(text);
-    length = std::min(static_cast<int>(t.length), length);
+    length = std::min(static_cast<Index>(t.length), length);
     if (sanitize_index(length, t.length) == End)
         return std::basic_string_view<E>{};
     return std::basic_string_view<E>(t.ptr, static_cast<size_t>(length));
 }
 
 template <typename T, typename E = container_type_t<T>>
-auto left(const T& text, int length)
+auto left(const T& text, Index length)
 {
     return std::basic_string<E>(left_view(text, length));
 }
 
 template <typename T, typename E = container_type_t<T>>
-auto right_view(const T& text, int length)
+auto right_view(const T& text, Index length)
 {
     Text t(text);
-    length = std::min(static_cast<int>(t.length), length);
+    length = std::min(static_cast<Index>(t.length), length);
     if (sanitize_index(length, t.length) == End)
         return std::basic_string_view<E>{};
     return std::basic_string_view<E>(t.ptr + t.length - length, static_cast<size_t>(length));
 }
 
 template <typename T, typename E = container_type_t<T>>
-auto right(const T& text, int length)
+auto right(const T& text, Index length)
 {
     return std::basic_string<E>(right_view(text, length));
 }
 
 template <typename T, typename E = container_type_t<T>>
-auto mid_view(const T& text, int start, int length = End)
+auto mid_view(const T& text, Index start, Index length = End)
 {
     Text t(text);
     if (sanitize_index(start, t.length) == End)
         return std::basic_string_view<E>{};
 
-    length = std::min(static_cast<int>(t.length) - start, length);
+    length = std::min(static_cast<Index>(t.length) - start, length);
     auto end = length < 0 ? length - 1 : start + length - 1;
     if (sanitize_index(end, t.length) == End)
         return std::basic_string_view<E>{};
@@ -51,9 +219,43 @@ auto mid_view(const T& text, int start, int length = End)
 }
 
 template <typename T, typename E = container_type_t<T>>
-auto mid(const T& text, int start, int length = End)
+auto mid(const T& text, Index start, Index length = End)
 {
     return std::basic_string<E>(mid_view(text, start, length));
 }
 
-} // namespace Text
\ No newline at end of file
+// Every step-th element of [start, end) without copying, a negative step takes them from the last one backwards.
+// Invalid range or zero step gives an empty view.
+template <typename T, typename E = container_type_t<T>>
+auto slice_view(const T& text, Index start = Start, Index end = End, Index step = Step)
+{
+    Text t(text);
+    if (step == 0 || sanitize_index(start, t.length) == End || sanitize_index(end, t.length) == End || start >= end)
+        return StridedView<E>{};
+    const auto distance = step > 0 ? step : -step;
+    const auto count = static_cast<size_t>((end - start - 1) / distance + 1);
+    return StridedView<E>(step > 0 ? t.ptr + start : t.ptr + end - 1, count, step);
+}
+
+template <typename T, typename E = container_type_t<T>>
+auto slice(const T& text, Index start = Start, Index end = End, Index step = Step)
+{
+    const auto view = slice_view(text, start, end, step);
+    return std::basic_string<E>(view.begin(), view.end());
+}
+
+} // namespace Text
+
+namespace detail {
+
+template <typename T>
+struct is_strided_view : std::false_type
+{};
+template <typename E>
+struct is_strided_view<Text::StridedView<E>> : std::true_type
+{};
+
+} // namespace detail
+
+template <typename E>
+inline constexpr bool std::ranges::enable_borrowed_range<Text::StridedView<E>> = true;
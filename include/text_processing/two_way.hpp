@@ -0,0 +1,153 @@
+#pragma once
+
+#include "common.hpp"
+
+namespace detail {
+
+// Bad character shifts. Wider types share a bucket by their lowest byte, which only makes the shift more
+// conservative.
+template <typename E>
+struct SkipTable
+{
+    static constexpr size_t buckets = 256;
+    std::array<size_t, buckets> shifts{};
+
+    static constexpr size_t bucket(E value)
+    {
+        return static_cast<size_t>(static_cast<std::make_unsigned_t<E>>(value)) % buckets;
+    }
+
+    template <typename Needle>
+    constexpr void init(Needle needle, size_t length)
+    {
+        shifts.fill(length);
+        for (size_t idx = 0; idx < length; ++idx)
+            shifts[bucket(needle(idx))] = length - 1 - idx;
+    }
+
+    constexpr size_t shift(E value) const
+    {
+        return shifts[bucket(value)];
+    }
+};
+
+// Two-Way string matching (Crochemore-Perrin) combined with Horspool bad character shifts, the same scheme
+// glibc uses for long needles. Bad character shifts skip most of the text on typical data, Two-Way critical
+// factorization keeps the worst case linear. Text and needle are accessed through callables taking an index,
+// so the same tables serve case folded and reversed searches. Requires totally ordered elements.
+template <typename E>
+struct TwoWay
+{
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+    size_t suffix = 0;
+    size_t period = 1;
+    bool periodic = false;
+    SkipTable<E> skip;
+
+    template <typename Needle>
+    constexpr TwoWay(Needle needle, size_t length)
+    {
+        size_t forward_period = 1;
+        size_t reverse_period = 1;
+        const auto forward_suffix = maximal_suffix(needle, length, false, forward_period);
+        const auto reverse_suffix = maximal_suffix(needle, length, true, reverse_period);
+        if (reverse_suffix + 1 < forward_suffix + 1)
+        {
+            suffix = forward_suffix + 1;
+            period = forward_period;
+        }
+        else
+        {
+            suffix = reverse_suffix + 1;
+            period = reverse_period;
+        }
+
+        periodic = suffix + period <= length;
+        for (size_t idx = 0; periodic && idx < suffix; ++idx)
+            periodic = needle(idx) == needle(idx + period);
+        if (!periodic)
+            period = std::max(suffix, length - suffix) + 1;
+        skip.init(needle, length);
+    }
+
+    // Returns index of first occurrence of needle in text or npos
+    template <typename Haystack, typename Needle>
+    constexpr size_t find(Haystack text, size_t text_length, Needle needle, size_t length) const
+    {
+        if (text_length < length)
+            return npos;
+        // Number of leading needle elements already known to match after a shift by period
+        size_t memory = 0;
+        for (size_t pos = 0; pos <= text_length - length;)
+        {
+            auto shift = skip.shift(text(pos + length - 1));
+            if (shift > 0)
+            {
+                if (periodic && memory > 0 && shift < period)
+                    shift = length - period;
+                memory = 0;
+                pos += shift;
+                continue;
+            }
+            // Last element falls into a bucket with zero shift, it still has to be compared for wide types
+            auto idx = std::max(suffix, memory);
+            while (idx < length && needle(idx) == text(pos + idx))
+                ++idx;
+            if (idx < length)
+            {
+                pos += idx - suffix + 1;
+                memory = 0;
+                continue;
+            }
+            idx = suffix;
+            while (idx > memory && needle(idx - 1) == text(pos + idx - 1))
+                --idx;
+            if (idx <= memory)
+                return pos;
+            pos += period;
+            memory = periodic ? length - period : 0;
+        }
+        return npos;
+    }
+
+private:
+    // Start of maximal suffix (minus one, wrapping for an empty prefix) for lexicographic order or its reverse
+    template <typename Needle>
+    static constexpr size_t maximal_suffix(Needle needle, size_t length, bool reversed, size_t& suffix_period)
+    {
+        size_t max_suffix = npos;
+        size_t pos = 0;
+        size_t offset = 1;
+        suffix_period = 1;
+        while (pos + offset < length)
+        {
+            const auto lhs = needle(pos + offset);
+            const auto rhs = needle(max_suffix + offset);
+            if (reversed ? rhs < lhs : lhs < rhs)
+            {
+                pos += offset;
+                offset = 1;
+                suffix_period = pos - max_suffix;
+            }
+            else if (lhs == rhs)
+            {
+                if (offset != suffix_period)
+                    ++offset;
+                else
+                {
+                    pos += suffix_period;
+                    offset = 1;
+                }
+            }
+            else
+            {
+                max_suffix = pos++;
+                offset = suffix_period = 1;
+            }
+        }
+        return max_suffix;
+    }
+};
+
+} // namespace detail
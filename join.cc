@@ -1,7 +1,13 @@
+#include "test_arena.hpp"
+
 #include <text_processing/join.hpp>
+#include <text_processing/split.hpp>
 
 #include <gtest/gtest.h>
 
+#include <list>
+#include <span>
+
 TEST(Join, SimpleWithView)
 {
     using namespace std::literals;
@@ -41,3 +47,54 @@ TEST(Join, WideView)
     auto result = Text::join(simple, L" ");
     EXPECT_EQ(result, L"simple string with words"s);
 }
+
+TEST(Join, AllocatorArena)
+{
+    using namespace std::literals;
+    TestArena<1024> arena;
+    std::pmr::vector<std::string_view> words({"simple"sv, "string"sv, "with"sv, "words"sv}, &arena.resource);
+    std::pmr::string result = Text::join(std::allocator_arg, words.get_allocator(), words, "_"sv);
+    EXPECT_EQ(result, "simple_string_with_words");
+    EXPECT_EQ(result.get_allocator().resource(), &arena.resource);
+    EXPECT_EQ(Text::join(words, " "sv), "simple string with words"s);
+}
+
+TEST(Join, AnyRange)
+{
+    using namespace std::literals;
+    std::array<std::string_view, 3> fixed{"a"sv, "bc"sv, ""sv};
+    EXPECT_EQ(Text::join(fixed, ", "sv), "a, bc, "s);
+    EXPECT_EQ(Text::join(std::span(fixed).first(2), '-'), "a-bc"s);
+    std::list<std::string> linked{"x", "y"};
+    EXPECT_EQ(Text::join(linked, "::"), "x::y"s);
+    std::vector<const char*> pointers{"c", "str"};
+    EXPECT_EQ(Text::join(pointers, "_"sv), "c_str"s);
+    EXPECT_EQ(Text::join(Text::split_view("a b  c"sv, ' ', Text::SplitBehavior::DropEmpty), ','), "a,b,c"s);
+    EXPECT_EQ(Text::join(std::vector<std::string>{}, ','), ""s);
+}
+
+TEST(Join, IntoExistingString)
+{
+    using namespace std::literals;
+    std::string line("id=");
+    std::vector<std::string_view> fields{"1"sv, "2"sv, "3"sv};
+    EXPECT_EQ(&Text::join_into(line, fields, ","sv), &line);
+    EXPECT_EQ(line, "id=1,2,3");
+    Text::join_into(line, std::vector<std::string_view>{}, ","sv);
+    EXPECT_EQ(line, "id=1,2,3");
+    Text::join_into(line, Text::split_view(";a;b"sv, ';'), '|');
+    EXPECT_EQ(line, "id=1,2,3|a|b");
+}
+
+TEST(Join, StridedViews)
+{
+    std::string table("a1x"
+                      "b2y"
+                      "c3z");
+    std::vector<Text::StridedView<char>> columns;
+    for (Text::Index column = 0; column < 3; ++column)
+        columns.push_back(Text::slice_view(table, column, Text::End, 3));
+    EXPECT_EQ(Text::join(columns, ','), "abc,123,xyz");
+    columns.push_back(Text::slice_view(table, Text::Start, Text::End, -4));
+    EXPECT_EQ(Text::join(columns, "; "), "abc; 123; xyz; z2a");
+}
@@ -0,0 +1,140 @@
+#include <text_processing/join_writer.hpp>
+#include <text_processing/split.hpp>
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#endif
+
+TEST(JoinWriter, SameAsJoin)
+{
+    using namespace std::literals;
+    std::vector<std::string> fields{"simple", "", "string", "with", "words"};
+    std::ostringstream output;
+    {
+        auto writer = Text::join_writer(output, ", "sv, 4);
+        writer.add_range(fields);
+    }
+    EXPECT_EQ(output.str(), Text::join(fields, ", "sv));
+}
+
+TEST(JoinWriter, LinesOfFields)
+{
+    using namespace std::literals;
+    std::wostringstream output;
+    auto writer = Text::join_writer(output, L',');
+    writer.add(L"a"sv).add(L'b').add(L"c");
+    writer.write(L'\n').restart();
+    writer.add(L"d"sv).write(L"\n"sv);
+    writer.flush();
+    EXPECT_EQ(output.str(), L"a,b,c\nd\n");
+}
+
+TEST(JoinWriter, SinkGetsBufferSizedPieces)
+{
+    using namespace std::literals;
+    std::vector<std::string> calls;
+    auto writer = Text::join_writer([&](std::string_view data) { calls.emplace_back(data); }, '|', 8);
+    writer.add("abc"sv);
+    EXPECT_TRUE(calls.empty());
+    writer.add("defgh"sv).add("ij"sv);
+    EXPECT_EQ(calls, (std::vector<std::string>{"abc|defg"}));
+    // Piece not shorter than the buffer is passed on directly after buffered data
+    writer.add("0123456789"sv);
+    EXPECT_EQ(calls, (std::vector<std::string>{"abc|defg", "h|ij|", "0123456789"}));
+    writer.add("k"sv);
+    writer.flush();
+    writer.flush();
+    EXPECT_EQ(calls.back(), "|k");
+    EXPECT_EQ(calls.size(), 4u);
+}
+
+TEST(JoinWriter, SplitFieldsRewritten)
+{
+    using namespace std::literals;
+    std::string output;
+    {
+        auto writer = Text::join_writer([&](std::string_view data) { output += data; }, "\t"sv, 16);
+        writer.add_range(Text::split_view("one,two,,three"sv, ','));
+    }
+    EXPECT_EQ(output, "one\ttwo\t\tthree");
+}
+
+#if !defined(_WIN32)
+TEST(JoinWriter, FileDescriptor)
+{
+    auto path = std::filesystem::temp_directory_path() / "text_processing_join_writer.txt";
+    const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    ASSERT_GE(fd, 0);
+    std::string large(100000, 'x');
+    std::string expected;
+    {
+        auto writer = Text::join_writer(fd, "\n", 1000);
+        for (int idx = 0; idx < 1000; ++idx)
+        {
+            const auto record = "record " + std::to_string(idx);
+            writer.add(record);
+            expected += (idx == 0 ? "" : "\n") + record;
+            if (idx % 100 == 0)
+            {
+                writer.add(large);
+                expected += "\n" + large;
+            }
+        }
+    }
+    ::close(fd);
+    std::ifstream input(path, std::ios::binary);
+    std::string contents((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    input.close();
+    std::filesystem::remove(path);
+    EXPECT_EQ(contents, expected);
+}
+
+TEST(JoinWriter, WriteErrorThrows)
+{
+    auto writer = Text::join_writer(-1, ',', 4);
+    writer.add("ab");
+    EXPECT_THROW(writer.add("cdefgh"), std::system_error);
+}
+
+namespace {
+ssize_t write_nothing(int, const void*, size_t)
+{
+    return 0;
+}
+
+ssize_t writev_nothing(int, const iovec*, int)
+{
+    return 0;
+}
+} // namespace
+
+TEST(JoinWriter, WriteOfNothingThrows)
+{
+    using Sink = detail::BasicFdSink<write_nothing, writev_nothing>;
+    auto expect_eio = [](auto write) {
+        try
+        {
+            write();
+            FAIL() << "system_error expected";
+        }
+        catch (const std::system_error& error)
+        {
+            EXPECT_EQ(error.code().value(), EIO);
+        }
+    };
+    Sink sink{1};
+    expect_eio([&] { sink("abc"); });
+    expect_eio([&] { sink("ab", "cdefgh"); });
+    auto writer = Text::join_writer(Sink{1}, ",", 4);
+    writer.add("ab");
+    expect_eio([&] { writer.add("cdefgh"); });
+    writer.add("a");
+    expect_eio([&] { writer.flush(); });
+}
+#endif
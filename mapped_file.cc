@@ -0,0 +1,69 @@
+#include <text_processing/count.hpp>
+#include <text_processing/find.hpp>
+#include <text_processing/mapped_file.hpp>
+#include <text_processing/split.hpp>
+#include <text_processing/sub.hpp>
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+namespace {
+
+std::filesystem::path write_file(const std::string& name, std::string_view contents)
+{
+    auto path = std::filesystem::temp_directory_path() / name;
+    std::ofstream(path, std::ios::binary) << contents;
+    return path;
+}
+
+} // namespace
+
+TEST(MappedFile, OperationsOnContents)
+{
+    using namespace std::literals;
+    auto path = write_file("text_processing_mapped_file.txt", "first line\nsecond line\nthird line\n");
+    {
+        Text::MappedFile file(path);
+        EXPECT_EQ(file.size(), 34u);
+        EXPECT_EQ(Text::find(file, "second"), 11);
+        EXPECT_EQ(Text::count(file, '\n'), 3);
+        auto lines = Text::split(file, '\n', Text::SplitBehavior::DropEmpty);
+        EXPECT_EQ(lines, (std::vector{"first line"sv, "second line"sv, "third line"sv}));
+        EXPECT_EQ(lines[0].data(), file.data());
+        EXPECT_EQ(Text::left_view(file, 5), "first"sv);
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(MappedFile, MoveKeepsMapping)
+{
+    using namespace std::literals;
+    auto path = write_file("text_processing_mapped_move.txt", "contents");
+    {
+        Text::MappedFile file(path, Text::AccessHint::Random);
+        const auto* data = file.data();
+        Text::MappedFile moved(std::move(file));
+        EXPECT_TRUE(file.empty());
+        EXPECT_EQ(moved.data(), data);
+        EXPECT_EQ(moved.view(), "contents"sv);
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(MappedFile, EmptyFile)
+{
+    auto path = write_file("text_processing_mapped_empty.txt", "");
+    {
+        Text::MappedFile file(path);
+        EXPECT_TRUE(file.empty());
+        EXPECT_EQ(Text::find(file, "a"), Text::End);
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(MappedFile, MissingFileThrows)
+{
+    EXPECT_THROW(Text::MappedFile(std::filesystem::temp_directory_path() / "text_processing_missing.txt"),
+                 std::system_error);
+}
@@ -0,0 +1,73 @@
+#include <text_processing/count.hpp>
+#include <text_processing/multi_searcher.hpp>
+
+#include <gtest/gtest.h>
+
+TEST(MultiSearcher, FindLeftmost)
+{
+    using namespace std::literals;
+    std::string simple("simple string with words");
+    std::vector<std::string> needles{"words", "with", "string"};
+    auto result = Text::find_first_of_words(simple, needles);
+    EXPECT_EQ(result, (Text::MultiMatch{7, 2, 6}));
+    EXPECT_EQ(Text::find_first_of_words(simple, needles, 8), (Text::MultiMatch{14, 1, 4}));
+    EXPECT_FALSE(Text::find_first_of_words(simple, needles, 8, 17).found());
+}
+
+TEST(MultiSearcher, LeftmostLongest)
+{
+    using namespace std::literals;
+    Text::MultiSearcher<char> searcher({"abcd"sv, "bc"sv, "ab"sv, "abc"sv});
+    EXPECT_EQ(Text::find_first_of_words("xabcdx"sv, searcher), (Text::MultiMatch{1, 0, 4}));
+    EXPECT_EQ(Text::find_first_of_words("xabcx"sv, searcher), (Text::MultiMatch{1, 3, 3}));
+    EXPECT_EQ(Text::find_first_of_words("xbcd"sv, searcher), (Text::MultiMatch{1, 1, 2}));
+    EXPECT_FALSE(Text::find_first_of_words("xacbd"sv, searcher).found());
+}
+
+TEST(MultiSearcher, CaseInsensitive)
+{
+    using namespace std::literals;
+    std::vector<std::string_view> needles{"ERROR"sv, "warn"sv};
+    Text::MultiSearcher searcher(needles, Text::Case::Insensitive);
+    EXPECT_EQ(Text::find_first_of_words("[Warn] disk [error]"sv, searcher), (Text::MultiMatch{1, 1, 4}));
+    EXPECT_FALSE(Text::find_first_of_words("[Warn] disk [error]"sv, needles).found());
+}
+
+TEST(MultiSearcher, CountEachSameAsCount)
+{
+    using namespace std::literals;
+    std::string text;
+    for (int idx = 0; idx < 200; ++idx)
+        text += "abcab"[idx % 5] + std::string(idx % 3, 'a');
+    std::vector<std::string> needles{"a", "ab", "aab", "bca", "", "ab", "caa", "zz"};
+    auto counts = Text::count_each(text, needles, 3, -5);
+    ASSERT_EQ(counts.size(), needles.size());
+    for (size_t idx = 0; idx < needles.size(); ++idx)
+        EXPECT_EQ(counts[idx], needles[idx].empty() ? 0 : Text::count(text, needles[idx], 3, -5)) << needles[idx];
+}
+
+TEST(MultiSearcher, WideText)
+{
+    using namespace std::literals;
+    std::vector<std::wstring> needles{L"Ąb", L"cd"};
+    EXPECT_EQ(Text::find_first_of_words(L"xxĄb"sv, needles), (Text::MultiMatch{2, 0, 2}));
+    EXPECT_EQ(Text::count_each(L"cdĄbcdcd"sv, needles), (std::vector<Text::Index>{1, 3}));
+}
+
+TEST(SplitMulti, Simple)
+{
+    using namespace std::literals;
+    std::vector<std::string_view> needles{", "sv, ";"sv, " and "sv};
+    auto result = Text::split_multi("one, two;three and four"sv, needles);
+    EXPECT_EQ(result, (std::vector<std::string_view>{"one"sv, "two"sv, "three"sv, "four"sv}));
+}
+
+TEST(SplitMulti, DropEmptyAndRange)
+{
+    using namespace std::literals;
+    std::vector<std::string_view> needles{"--"sv, "-"sv};
+    auto keep = Text::split_multi("a---b-c"sv, needles);
+    EXPECT_EQ(keep, (std::vector<std::string_view>{"a"sv, ""sv, "b"sv, "c"sv}));
+    auto drop = Text::split_multi("a---b-c"sv, needles, Text::SplitBehavior::DropEmpty, 2);
+    EXPECT_EQ(drop, (std::vector<std::string_view>{"a-"sv, "b"sv, "c"sv}));
+}
@@ -0,0 +1,98 @@
+#include <text_processing/parallel.hpp>
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <stdexcept>
+
+namespace {
+
+std::string random_text(size_t length, unsigned seed)
+{
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> letter(0, 3);
+    std::string text(length, ' ');
+    for (auto& ch : text)
+        ch = "abcA"[letter(gen)];
+    return text;
+}
+
+} // namespace
+
+TEST(ThreadPool, RunsEveryTask)
+{
+    Text::ThreadPool pool(4);
+    EXPECT_EQ(pool.concurrency(), 4u);
+    for (size_t tasks : {0u, 1u, 3u, 100u})
+    {
+        std::vector<int> done(tasks);
+        pool.bulk(tasks, [&](size_t task) { ++done[task]; });
+        EXPECT_EQ(std::count(done.begin(), done.end(), 1), static_cast<std::ptrdiff_t>(tasks));
+    }
+}
+
+TEST(ThreadPool, RethrowsTaskError)
+{
+    Text::ThreadPool pool(3);
+    EXPECT_THROW(pool.bulk(10,
+                           [](size_t task) {
+                               if (task == 7)
+                                   throw std::runtime_error("task failed");
+                           }),
+                 std::runtime_error);
+    size_t sum = 0;
+    pool.bulk(1, [&](size_t) { sum = 42; });
+    EXPECT_EQ(sum, 42u);
+}
+
+TEST(ParallelCount, SameAsCount)
+{
+    using namespace std::literals;
+    Text::ThreadPool pool(4);
+    Text::SequentialExecutor sequential;
+    auto text = random_text(size_t{1} << 20, 3);
+    for (Text::Index step : {1, 2, 3, -1, -2})
+        for (auto needle : {"a"sv, "ab"sv, "abca"sv})
+        {
+            auto expected = Text::count(text, needle, 5, -7, step);
+            EXPECT_EQ(Text::count(pool, text, needle, 5, -7, step), expected) << needle << " " << step;
+            EXPECT_EQ(Text::count(sequential, text, needle, 5, -7, step), expected);
+        }
+    EXPECT_EQ(Text::count(pool, text, "ab", Text::Start, Text::End, Text::Step, Text::Case::Insensitive),
+              Text::count(text, "ab", Text::Start, Text::End, Text::Step, Text::Case::Insensitive));
+    EXPECT_EQ(Text::count_any(pool, text, "bc"sv, 3, Text::End, 2), Text::count_any(text, "bc"sv, 3, Text::End, 2));
+}
+
+TEST(ParallelFind, SameAsFind)
+{
+    using namespace std::literals;
+    Text::ThreadPool pool(4);
+    auto text = random_text(size_t{1} << 20, 5);
+    text[700000] = 'x';
+    text[900000] = 'x';
+    text[900001] = 'y';
+    EXPECT_EQ(Text::find(pool, text, "x"sv), 700000);
+    EXPECT_EQ(Text::find(pool, text, "xy"sv), 900000);
+    EXPECT_EQ(Text::find(pool, text, "x"sv, Text::Start, Text::End, -1), 900000);
+    EXPECT_EQ(Text::find(pool, text, "x"sv, Text::Start, 800000, -1), 700000);
+    EXPECT_EQ(Text::find(pool, text, "x"sv, 800000, 900001, -2), 900000);
+    EXPECT_EQ(Text::find(pool, text, "x"sv, Text::Start, Text::End, 3), 900000);
+    EXPECT_EQ(Text::find(pool, text, "x"sv, 800000, Text::End, -1, Text::Case::Insensitive), 900000);
+    EXPECT_EQ(Text::find(pool, text, "zz"sv), Text::End);
+    EXPECT_EQ(Text::find_any(pool, text, "yx"sv), 700000);
+    EXPECT_EQ(Text::find_any(pool, text, "yx"sv, Text::Start, Text::End, -1), 900001);
+
+    for (Text::Index step : {1, 2, 5, -1, -3})
+        for (auto needle : {"ab"sv, "bacab"sv, "Ab"sv})
+        {
+            EXPECT_EQ(Text::find(pool, text, needle, 11, -13, step), Text::find(text, needle, 11, -13, step))
+                << needle << " " << step;
+            EXPECT_EQ(Text::find_any(pool, text, needle, 11, -13, step), Text::find_any(text, needle, 11, -13, step))
+                << needle << " " << step;
+        }
+
+    // Negative step searches below start as well
+    EXPECT_EQ(Text::find(pool, "xab"sv, "x"sv, 1, 3, -1), Text::find("xab"sv, "x"sv, 1, 3, -1));
+    EXPECT_EQ(Text::find_any(pool, "xab"sv, "x"sv, 1, 3, -2), Text::find_any("xab"sv, "x"sv, 1, 3, -2));
+    EXPECT_EQ(Text::find(pool, "xab"sv, "x"sv, 5, 3, -1), Text::End);
+}
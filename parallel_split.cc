@@ -0,0 +1,59 @@
+#include <text_processing/parallel_split.hpp>
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+TEST(ParallelSplit, SameAsSplit)
+{
+    using namespace std::literals;
+    auto text = "first line\nsecond line\n\nthird line\nlast"sv;
+    for (size_t threads : {1u, 2u, 3u, 8u})
+    {
+        EXPECT_EQ(Text::parallel_split(text, '\n', Text::SplitBehavior::KeepEmpty, Text::Start, Text::End,
+                                       Text::Step, Text::Case::Sensitive, threads),
+                  Text::split(text, '\n'));
+        EXPECT_EQ(Text::parallel_split(text, " line"sv, Text::SplitBehavior::DropEmpty, Text::Start, Text::End,
+                                       Text::Step, Text::Case::Sensitive, threads),
+                  Text::split(text, " line"sv, Text::SplitBehavior::DropEmpty));
+    }
+}
+
+TEST(ParallelSplit, RandomTextsMatchSplit)
+{
+    using namespace std::literals;
+    std::mt19937 gen(11);
+    std::uniform_int_distribution<int> letter(0, 2);
+    for (int idx = 0; idx < 300; ++idx)
+    {
+        std::string text;
+        for (auto pos = gen() % 80; pos > 0; --pos)
+            text += "ab,"[letter(gen)];
+        auto start = static_cast<Text::Index>(gen() % 5);
+        auto end = -static_cast<Text::Index>(gen() % 5) - 1;
+        auto step = static_cast<Text::Index>(gen() % 3 + 1);
+        auto beh = gen() % 2 ? Text::SplitBehavior::KeepEmpty : Text::SplitBehavior::DropEmpty;
+        for (size_t threads : {2u, 3u, 7u})
+        {
+            for (auto needle : {","sv, "aa"sv, "a,a"sv})
+                EXPECT_EQ(Text::parallel_split(text, needle, beh, start, end, step, Text::Case::Sensitive, threads),
+                          Text::split(text, needle, beh, start, end, step))
+                    << text << " " << needle << " " << step;
+            EXPECT_EQ(Text::parallel_split_any(text, "b,"sv, beh, start, end, step, Text::Case::Sensitive, threads),
+                      Text::split_any(text, "b,"sv, beh, start, end, step));
+            auto is_comma = [](char ch) { return ch == ','; };
+            EXPECT_EQ(Text::parallel_split_if(text, is_comma, beh, start, end, step, threads),
+                      Text::split_if(text, is_comma, beh, start, end, step));
+        }
+    }
+}
+
+TEST(ParallelSplit, LargeText)
+{
+    std::string text;
+    for (int idx = 0; idx < 200000; ++idx)
+        text += "field" + std::to_string(idx) + ";;";
+    auto result = Text::parallel_split(text, ";;");
+    EXPECT_EQ(result, Text::split(text, ";;"));
+    EXPECT_EQ(result.size(), 200001u);
+}
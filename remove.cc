@@ -1,3 +1,5 @@
+#include "test_arena.hpp"
+
 #include <text_processing/remove.hpp>
 
 #include <gtest/gtest.h>
@@ -83,6 +85,36 @@ TEST(Remove, WithSteps)
     EXPECT_EQ(simple, "simple tring with word"s);
 }
 
+TEST(Remove, NonPositiveStepKeepsText)
+{
+    using namespace std::literals;
+    const std::string original(",a,b,c");
+    auto is_comma = [](char ch) { return ch == ','; };
+    for (Text::Index step : {0, -1})
+    {
+        std::string simple(original);
+        EXPECT_EQ(Text::remove(simple, ","sv, Text::Start, Text::End, step), 0);
+        EXPECT_EQ(simple, original);
+        EXPECT_EQ(Text::remove_any(simple, ",b"sv, Text::Start, Text::End, step), 0);
+        EXPECT_EQ(simple, original);
+        EXPECT_EQ(Text::remove_if(simple, is_comma, Text::Start, Text::End, step), 0);
+        EXPECT_EQ(simple, original);
+        EXPECT_EQ(Text::remove_impl(original, ","sv, Text::Start, Text::End, step, Text::Case::Sensitive).text,
+                  original);
+        EXPECT_EQ(Text::removed(original, ","sv, Text::Start, Text::End, step), original);
+        EXPECT_EQ(Text::removed_any(original, ",b"sv, Text::Start, Text::End, step), original);
+        EXPECT_EQ(Text::removed_if(original, is_comma, Text::Start, Text::End, step), original);
+
+        std::array<char, 8> buffer{};
+        auto* last = Text::removed_into(original, ","sv, buffer.data(), Text::Start, Text::End, step);
+        EXPECT_EQ(std::string_view(buffer.data(), last), original);
+        last = Text::removed_any_into(original, ",b"sv, buffer.data(), Text::Start, Text::End, step);
+        EXPECT_EQ(std::string_view(buffer.data(), last), original);
+        last = Text::removed_if_into(original, is_comma, buffer.data(), Text::Start, Text::End, step);
+        EXPECT_EQ(std::string_view(buffer.data(), last), original);
+    }
+}
+
 TEST(RemoveIf, ConstVersion)
 {
     using namespace std::literals;
@@ -167,4 +199,93 @@ TEST(RemoveAny, CaseInsensitive)
 }
 
 
+TEST(Remove, AllocatorArena)
+{
+    using namespace std::literals;
+    TestArena arena;
+    auto alloc = arena.allocator();
+    std::string_view simple("simple string with words");
+    std::pmr::string result = Text::removed(std::allocator_arg, alloc, simple, "s"sv);
+    EXPECT_EQ(result, "imple tring with word");
+    EXPECT_EQ(result.get_allocator().resource(), &arena.resource);
+    EXPECT_EQ(Text::removed_any(std::allocator_arg, alloc, simple, "tg"sv), "simple srin wih words");
+    EXPECT_EQ(Text::removed_if(std::allocator_arg, alloc, simple, [](char ch) { return ch == ' '; }),
+              "simplestringwithwords");
+    Text::pmr::RemoveResult<char> removed = Text::remove_impl(simple, "s"sv, Text::Start, Text::End, Text::Step,
+                                                              Text::Case::Sensitive, alloc);
+    EXPECT_EQ(removed.operations, 3);
+
+    std::pmr::string text(simple, alloc);
+    EXPECT_EQ(Text::remove(text, "s"sv), 3);
+    EXPECT_EQ(text, result);
+}
+
+TEST(Remove, InPlaceMatchesSplitJoin)
+{
+    using namespace std::literals;
+    std::string simple("simple String with words,\tsimple\x01string with\r\nmore words and some control\x7f chars");
+    auto control = [](char ch) { return static_cast<unsigned char>(ch) < 0x20 || ch == 0x7f; };
+    for (auto [start, end] : {std::pair<Text::Index, Text::Index>{Text::Start, Text::End}, {3, -4}, {17, 40}, {5, 5}})
+    {
+        for (auto step : {1, 2, 3})
+        {
+            std::string copy(simple);
+            auto expected = Text::remove_impl(simple, "s"sv, start, end, step, Text::Case::Insensitive);
+            EXPECT_EQ(Text::remove(copy, "s"sv, start, end, step, Text::Case::Insensitive), expected.operations);
+            EXPECT_EQ(copy, expected.text);
+            copy = simple;
+            expected = Text::remove_any_impl(simple, "sw\t\x01"sv, start, end, step, Text::Case::Insensitive);
+            EXPECT_EQ(Text::remove_any(copy, "sw\t\x01"sv, start, end, step, Text::Case::Insensitive),
+                      expected.operations);
+            EXPECT_EQ(copy, expected.text);
+            copy = simple;
+            expected = Text::remove_if_impl(simple, control, start, end, step);
+            EXPECT_EQ(Text::remove_if(copy, control, start, end, step), expected.operations);
+            EXPECT_EQ(copy, expected.text);
+        }
+    }
+}
+
+TEST(Remove, IntoBuffer)
+{
+    using namespace std::literals;
+    std::string_view simple("simple string with words");
+    std::array<char, 32> buffer{};
+    auto* last = Text::removed_into(simple, "s"sv, buffer.data());
+    EXPECT_EQ(std::string_view(buffer.data(), last), "imple tring with word"sv);
+    last = Text::removed_any_into(simple, "tg"sv, buffer.data(), 7);
+    EXPECT_EQ(std::string_view(buffer.data(), last), "simple srin wih words"sv);
+    last = Text::removed_if_into(simple, [](char ch) { return ch == ' '; }, buffer.data(), Text::Start, Text::End, 2);
+    EXPECT_EQ(std::string_view(buffer.data(), last), Text::removed_if(simple, [](char ch) { return ch == ' '; },
+                                                                     Text::Start, Text::End, 2));
+    std::wstring out;
+    Text::removed_into(L"a--b--c"sv, L"--"sv, std::back_inserter(out));
+    EXPECT_EQ(out, L"abc");
+}
+
+TEST(Remove, IntoBufferWritesOnlyResult)
+{
+    using namespace std::literals;
+    std::string text;
+    for (size_t idx = 0; idx < 3000; ++idx)
+        text += "ab,\n-cd"[(idx * 7 + idx / 5) % 7];
+    text += ",,,,,,,,,,,,,,,,,,,,";
+    auto is_comma = [](char ch) { return ch == ','; };
+    for (Text::Index start : {0, 3, 1500})
+    {
+        const auto expected = Text::removed_any(text, ",\n"sv, start);
+        // Elements after the result have to stay untouched
+        std::vector<char> buffer(expected.size() + 32, '#');
+        auto* last = Text::removed_any_into(text, ",\n"sv, buffer.data(), start);
+        EXPECT_EQ(std::string_view(buffer.data(), last), expected);
+        EXPECT_EQ(std::count(last, buffer.data() + buffer.size(), '#'), 32);
+
+        const auto expected_if = Text::removed_if(text, is_comma, start);
+        buffer.assign(expected_if.size() + 32, '#');
+        last = Text::removed_if_into(text, is_comma, buffer.data(), start);
+        EXPECT_EQ(std::string_view(buffer.data(), last), expected_if);
+        EXPECT_EQ(std::count(last, buffer.data() + buffer.size(), '#'), 32);
+    }
+}
+
 //Add steps for replace/split
\ No newline at end of file
@@ -1,3 +1,5 @@
+#include "test_arena.hpp"
+
 #include <text_processing/replace.hpp>
 
 #include <gtest/gtest.h>
@@ -140,3 +142,74 @@ TEST(ReplaceAny, WithSteps)
     EXPECT_EQ(result, 3);
     EXPECT_EQ(simple, "simple _tring with _ord_"s);
 }
+
+TEST(Replace, InPlaceSameLength)
+{
+    using namespace std::literals;
+    std::string simple("one::two::three::");
+    const auto* data = simple.data();
+    auto result = Text::replace(simple, "::"sv, "--"sv);
+    EXPECT_EQ(result, 3);
+    EXPECT_EQ(simple, "one--two--three--"s);
+    EXPECT_EQ(simple.data(), data);
+}
+
+TEST(Replace, InPlaceShorter)
+{
+    using namespace std::literals;
+    std::string simple("<br>one<br><br>two<br>");
+    auto result = Text::replace(simple, "<br>"sv, "\n"sv);
+    EXPECT_EQ(result, 4);
+    EXPECT_EQ(simple, "\none\n\ntwo\n"s);
+    std::string removed("aXbXXc");
+    EXPECT_EQ(Text::replace(removed, "X"sv, ""sv), 3);
+    EXPECT_EQ(removed, "abc"s);
+}
+
+TEST(Replace, InPlaceMatchesReplaced)
+{
+    using namespace std::literals;
+    std::string simple("simple String with words, simple string with more words");
+    for (auto step : {1, 2, 3})
+    {
+        for (auto replacement : {"S"sv, "s_"sv, "#"sv, ""sv})
+        {
+            std::string copy(simple);
+            auto expected = Text::replaced(simple, "s"sv, replacement, 3, -4, step, Text::Case::Insensitive);
+            Text::replace(copy, "s"sv, replacement, 3, -4, step, Text::Case::Insensitive);
+            EXPECT_EQ(copy, expected);
+            copy = simple;
+            expected = Text::replaced_any(simple, "sw"sv, replacement, 3, -4, step);
+            Text::replace_any(copy, "sw"sv, replacement, 3, -4, step);
+            EXPECT_EQ(copy, expected);
+            copy = simple;
+            expected = Text::replaced_if(simple, [](char ch) { return ch > 'r'; }, replacement, 3, -4, step);
+            Text::replace_if(copy, [](char ch) { return ch > 'r'; }, replacement, 3, -4, step);
+            EXPECT_EQ(copy, expected);
+        }
+    }
+}
+
+TEST(Replace, AllocatorArena)
+{
+    using namespace std::literals;
+    TestArena arena;
+    auto alloc = arena.allocator();
+    std::string_view simple("simple string with words");
+    std::pmr::string result = Text::replaced(std::allocator_arg, alloc, simple, "s"sv, "ss"sv);
+    EXPECT_EQ(result, "ssimple sstring with wordss"sv);
+    EXPECT_EQ(result.get_allocator().resource(), &arena.resource);
+    EXPECT_EQ(Text::replaced_any(std::allocator_arg, alloc, simple, "sw"sv, "_"sv), "_imple _tring _ith _ord_"sv);
+    auto pred = [](char ch) { return ch > 'r'; };
+    EXPECT_EQ(Text::replaced_if(std::allocator_arg, alloc, simple, pred, "#"sv), "#imple ##ring #i#h #ord#"sv);
+    Text::pmr::ReplaceResult<char> unchanged = Text::replace_impl(simple, "s"sv, "ss"sv, 0, 0, -1,
+                                                                    Text::Case::Sensitive, alloc);
+    EXPECT_EQ(unchanged.text, simple);
+    EXPECT_EQ(unchanged.operations, 0);
+
+    // Strings using an arena are rebuilt in it when replacement is longer than a needle
+    std::pmr::string text(simple, alloc);
+    EXPECT_EQ(Text::replace(text, "s"sv, "ss"sv), 3);
+    EXPECT_EQ(text, result);
+    EXPECT_EQ(text.get_allocator().resource(), &arena.resource);
+}
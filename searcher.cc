@@ -0,0 +1,147 @@
+#include <text_processing/count.hpp>
+#include <text_processing/find.hpp>
+#include <text_processing/remove.hpp>
+#include <text_processing/replace.hpp>
+#include <text_processing/searcher.hpp>
+#include <text_processing/split.hpp>
+
+#include <gtest/gtest.h>
+
+TEST(Searcher, FindSameAsNeedle)
+{
+    using namespace std::literals;
+    std::string simple("simple string with words");
+    Text::Searcher searcher(" "sv);
+    EXPECT_EQ(Text::find(simple, searcher), 6);
+    EXPECT_EQ(Text::find(simple, searcher, 7), 13);
+    EXPECT_EQ(Text::rfind(simple, searcher), 18);
+    EXPECT_EQ(Text::find(simple, searcher, 1, Text::End, 2), 13);
+}
+
+TEST(Searcher, FromCharLiteralAndElement)
+{
+    std::string simple("simple string with words");
+    Text::Searcher literal("with");
+    Text::Searcher element('w');
+    EXPECT_EQ(Text::find(simple, literal), 14);
+    EXPECT_EQ(Text::find(simple, element), 14);
+}
+
+TEST(Searcher, CaseInsensitive)
+{
+    using namespace std::literals;
+    std::string simple("simple String WITH words");
+    Text::Searcher searcher("With"sv, Text::Case::Insensitive);
+    EXPECT_EQ(searcher.needle, std::vector<char>({'w', 'i', 't', 'h'}));
+    EXPECT_EQ(Text::find(simple, searcher), 14);
+    // Case is fixed by searcher
+    EXPECT_EQ(Text::find(simple, searcher, Text::Start, Text::End, Text::Step, Text::Case::Sensitive), 14);
+    EXPECT_EQ(Text::rfind(simple, searcher), 14);
+}
+
+TEST(Searcher, ReusedForMultipleTexts)
+{
+    using namespace std::literals;
+    Text::Searcher searcher("ab"sv);
+    std::vector<std::string> texts{"ab", "xxab", "xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxab", "ba"};
+    std::vector<Text::Index> expected{0, 2, 36, Text::End};
+    for (size_t idx = 0; idx < texts.size(); ++idx)
+        EXPECT_EQ(Text::find(texts[idx], searcher), expected[idx]);
+}
+
+TEST(Searcher, WideTextWithTwoWay)
+{
+    using namespace std::literals;
+    std::wstring simple(L"simple string with words, simple string with more words");
+    Text::Searcher searcher(L"with more"sv);
+    EXPECT_TRUE(searcher.uses_two_way());
+    EXPECT_EQ(Text::find(simple, searcher), 40);
+    Text::Searcher insensitive(L"WITH MORE"sv, Text::Case::Insensitive);
+    EXPECT_EQ(Text::find(simple, insensitive), 40);
+    EXPECT_EQ(Text::count(simple, Text::Searcher(L"words"sv)), 2);
+}
+
+TEST(Searcher, LongNeedle)
+{
+    using namespace std::literals;
+    std::string simple(500, 'a');
+    simple.replace(100, 40, std::string(39, 'a') + "b");
+    simple.replace(300, 40, std::string(39, 'a') + "b");
+    Text::Searcher searcher(std::string(39, 'a') + "b");
+    EXPECT_TRUE(searcher.uses_two_way());
+    EXPECT_EQ(Text::find(simple, searcher), 100);
+    EXPECT_EQ(Text::rfind(simple, searcher), 300);
+    EXPECT_EQ(Text::count(simple, searcher), 2);
+}
+
+TEST(Searcher, CustomType)
+{
+    struct MyType
+    {
+        int val;
+        bool operator==(const MyType&) const = default;
+    };
+
+    std::vector<MyType> simple{{0}, {1337}, {12}, {1337}, {12}};
+    Text::Searcher searcher(std::vector<MyType>{{1337}, {12}});
+    EXPECT_EQ(Text::find(simple, searcher), 1);
+    EXPECT_EQ(Text::count(simple, searcher), 2);
+}
+
+TEST(Searcher, Count)
+{
+    using namespace std::literals;
+    Text::Searcher searcher(" s"sv);
+    EXPECT_EQ(Text::count(" simple string with words"sv, searcher), 2);
+}
+
+TEST(Searcher, Split)
+{
+    using namespace std::literals;
+    std::string simple("simple, string, with, words");
+    Text::Searcher searcher(", "sv);
+    auto result = Text::split(simple, searcher);
+    auto expected = std::vector<std::string_view>{"simple"sv, "string"sv, "with"sv, "words"sv};
+    EXPECT_EQ(result, expected);
+}
+
+TEST(Searcher, ReplaceAndRemove)
+{
+    using namespace std::literals;
+    std::string simple("simple string with words");
+    Text::Searcher searcher("S"sv, Text::Case::Insensitive);
+    EXPECT_EQ(Text::replaced(simple, searcher, "z"sv), "zimple ztring with wordz");
+    EXPECT_EQ(Text::removed(simple, searcher), "imple tring with word");
+    EXPECT_EQ(Text::remove(simple, searcher), 3);
+    EXPECT_EQ(simple, "imple tring with word");
+}
+
+TEST(AnySearcher, FindAny)
+{
+    using namespace std::literals;
+    std::string simple("simple string with words");
+    Text::AnySearcher searcher("tg"sv);
+    EXPECT_EQ(Text::find_any(simple, searcher), 8);
+    EXPECT_EQ(Text::rfind_any(simple, searcher), 16);
+    EXPECT_EQ(Text::count_any(simple, searcher), 3);
+}
+
+TEST(AnySearcher, CaseInsensitive)
+{
+    using namespace std::literals;
+    std::string simple("simple String With words");
+    Text::AnySearcher searcher("Sw", Text::Case::Insensitive);
+    EXPECT_EQ(Text::count_any(simple, searcher), 5);
+    auto result = Text::split_any(simple, searcher, Text::SplitBehavior::DropEmpty);
+    auto expected = std::vector<std::string_view>{"imple "sv, "tring "sv, "ith "sv, "ord"sv};
+    EXPECT_EQ(result, expected);
+}
+
+TEST(AnySearcher, ReplaceAndRemove)
+{
+    using namespace std::literals;
+    std::string simple("simple string with words");
+    Text::AnySearcher searcher(" i"sv);
+    EXPECT_EQ(Text::replaced_any(simple, searcher, "_"sv), "s_mple_str_ng_w_th_words");
+    EXPECT_EQ(Text::removed_any(simple, searcher), "smplestrngwthwords");
+}
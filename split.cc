@@ -1,3 +1,5 @@
+#include "test_arena.hpp"
+
 #include <text_processing/split.hpp>
 
 #include <gtest/gtest.h>
@@ -333,3 +335,145 @@ TEST(SplitAny, WithSteps)
     EXPECT_EQ(result_keep, expected_keep);
     EXPECT_EQ(result_drop, expected_drop);
 }
+
+TEST(SplitAny, LongTextWhitespace)
+{
+    using namespace std::literals;
+    std::string simple;
+    for (int idx = 0; idx < 50; ++idx)
+        simple += "word\tother, next\n";
+    auto result = Text::split_any(simple, " \t\n,"sv, Text::SplitBehavior::DropEmpty);
+    ASSERT_EQ(result.size(), 150);
+    EXPECT_EQ(result[0], "word"sv);
+    EXPECT_EQ(result[1], "other"sv);
+    EXPECT_EQ(result[149], "next"sv);
+}
+
+TEST(SplitView, SameAsSplit)
+{
+    using namespace std::literals;
+    std::string simple("simple string  with words ");
+    for (auto beh : {Text::SplitBehavior::KeepEmpty, Text::SplitBehavior::DropEmpty})
+    {
+        auto view = Text::split_view(simple, " "sv, beh);
+        std::vector<std::string_view> result(view.begin(), view.end());
+        EXPECT_EQ(result, Text::split(simple, " "sv, beh));
+    }
+}
+
+TEST(SplitView, StepsAndCase)
+{
+    using namespace std::literals;
+    std::string simple("simple String with words");
+    auto view = Text::split_view(simple, "s", Text::SplitBehavior::KeepEmpty, 1, Text::End, 2, Text::Case::Insensitive);
+    std::vector<std::string_view> result(view.begin(), view.end());
+    EXPECT_EQ(result, Text::split(simple, "s", Text::SplitBehavior::KeepEmpty, 1, Text::End, 2, Text::Case::Insensitive));
+    auto blocks = Text::split_view(simple, "", Text::SplitBehavior::KeepEmpty, Text::Start, Text::End, 5);
+    std::vector<std::string_view> blocks_result(blocks.begin(), blocks.end());
+    EXPECT_EQ(blocks_result, Text::split(simple, "", Text::SplitBehavior::KeepEmpty, Text::Start, Text::End, 5));
+}
+
+TEST(SplitView, Take)
+{
+    using namespace std::literals;
+    std::string simple("a,b,c,d");
+    auto view = Text::split_view(simple, ',');
+    std::vector<std::string_view> result;
+    for (auto word : view | std::views::take(2))
+        result.push_back(word);
+    EXPECT_EQ(result, (std::vector<std::string_view>{"a"sv, "b"sv}));
+}
+
+TEST(SplitView, Searcher)
+{
+    using namespace std::literals;
+    std::string simple("one::two::::three");
+    Text::Searcher needle("::"sv);
+    auto view = Text::split_view(simple, needle, Text::SplitBehavior::DropEmpty);
+    std::vector<std::string_view> result(view.begin(), view.end());
+    EXPECT_EQ(result, (std::vector<std::string_view>{"one"sv, "two"sv, "three"sv}));
+}
+
+TEST(SplitView, DropEmptyKeepsTail)
+{
+    using namespace std::literals;
+    EXPECT_EQ(Text::split("x::y"sv, "::"sv, Text::SplitBehavior::DropEmpty),
+              (std::vector<std::string_view>{"x"sv, "y"sv}));
+    EXPECT_EQ(Text::split("a b c"sv, " "sv, Text::SplitBehavior::DropEmpty, Text::Start, 2),
+              (std::vector<std::string_view>{"a"sv, "b c"sv}));
+}
+
+TEST(SplitAnyView, SameAsSplitAny)
+{
+    using namespace std::literals;
+    std::string simple("word\tother, next\n");
+    auto view = Text::split_any_view(simple, " \t\n,"sv, Text::SplitBehavior::DropEmpty);
+    std::vector<std::string_view> result(view.begin(), view.end());
+    EXPECT_EQ(result, Text::split_any(simple, " \t\n,"sv, Text::SplitBehavior::DropEmpty));
+    Text::AnySearcher delimiters(" \t\n,"sv);
+    auto searcher_view = Text::split_any_view(simple, delimiters);
+    std::vector<std::string_view> searcher_result(searcher_view.begin(), searcher_view.end());
+    EXPECT_EQ(searcher_result, Text::split_any(simple, " \t\n,"sv));
+}
+
+TEST(SplitIfView, SameAsSplitIf)
+{
+    std::string simple("simple string with words");
+    auto pred = [](char ch) { return ch > 'r'; };
+    auto view = Text::split_if_view(simple, pred, Text::SplitBehavior::DropEmpty);
+    std::vector<std::string_view> result(view.begin(), view.end());
+    EXPECT_EQ(result, Text::split_if(simple, pred, Text::SplitBehavior::DropEmpty));
+}
+
+TEST(Split, AllocatorArena)
+{
+    using namespace std::literals;
+    TestArena<1024> arena;
+    auto alloc = arena.allocator();
+    std::pmr::vector<std::string_view> result =
+        Text::split(std::allocator_arg, alloc, "simple string with words"sv, " "sv);
+    EXPECT_EQ(result, (std::pmr::vector<std::string_view>{"simple"sv, "string"sv, "with"sv, "words"sv}));
+    EXPECT_EQ(result.get_allocator().resource(), &arena.resource);
+    EXPECT_EQ(Text::split_any(std::allocator_arg, alloc, "a,b;c"sv, ",;"sv).size(), 3);
+    EXPECT_EQ(Text::split_if(std::allocator_arg, alloc, "a1b2c"sv, [](char ch) { return ch < 'a'; }).size(), 3);
+}
+
+TEST(Split, StridedView)
+{
+    using namespace std::literals;
+    // First element of every two element record
+    std::string records("a.b.;.c.d.;.;.e.");
+    auto column = Text::slice_view(records, Text::Start, Text::End, 2);
+    std::vector<Text::StridedView<char>> fields = Text::split(column, ';');
+    std::vector<std::string> result;
+    for (auto field : fields)
+        result.emplace_back(field.begin(), field.end());
+    EXPECT_EQ(result, (std::vector<std::string>{"ab", "cd", "", "e"}));
+    EXPECT_EQ(&fields[1][0], records.data() + 6);
+    EXPECT_EQ(Text::split(column, ";"sv, Text::SplitBehavior::DropEmpty).size(), 3);
+    EXPECT_EQ(Text::split(column, ""sv, Text::SplitBehavior::KeepEmpty, 1, Text::End, 3).size(), 3);
+}
+
+TEST(Split, StridedViewMatchesCopy)
+{
+    std::string text;
+    for (size_t idx = 0; idx < 97; ++idx)
+        text += "abc"[(idx * idx + idx / 3) % 3];
+    for (Text::Index stride : {-3, -2, 2, 3})
+    {
+        auto view = Text::slice_view(text, 2, Text::End, stride);
+        auto copy = Text::slice(text, 2, Text::End, stride);
+        for (auto needle : {"a", "ab", "bca", ""})
+            for (Text::Index step : {1, 2, 3})
+                for (auto beh : {Text::SplitBehavior::KeepEmpty, Text::SplitBehavior::DropEmpty})
+                {
+                    std::vector<std::string> result;
+                    for (auto fragment : Text::split(view, needle, beh, 3, -4, step))
+                        result.emplace_back(fragment.begin(), fragment.end());
+                    std::vector<std::string> expected;
+                    for (auto fragment : Text::split(copy, needle, beh, 3, -4, step))
+                        expected.emplace_back(fragment);
+                    EXPECT_EQ(result, expected);
+                }
+    }
+}
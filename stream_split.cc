@@ -0,0 +1,107 @@
+#include <text_processing/stream_split.hpp>
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#endif
+
+namespace {
+
+template <typename Splitter>
+std::vector<std::string> collect(Splitter&& splitter)
+{
+    std::vector<std::string> records;
+    for (auto record : splitter)
+        records.emplace_back(record);
+    return records;
+}
+
+} // namespace
+
+TEST(StreamSplit, Lines)
+{
+    std::istringstream input("first\nsecond\n\nlast");
+    auto records = collect(Text::split_stream(input, '\n'));
+    EXPECT_EQ(records, (std::vector<std::string>{"first", "second", "", "last"}));
+}
+
+TEST(StreamSplit, DropEmpty)
+{
+    std::istringstream input("\nfirst\n\nsecond\n");
+    auto records = collect(Text::split_stream(input, '\n', Text::SplitBehavior::DropEmpty));
+    EXPECT_EQ(records, (std::vector<std::string>{"first", "second"}));
+}
+
+TEST(StreamSplit, DelimiterSpanningChunks)
+{
+    using namespace std::literals;
+    std::istringstream input("ab<->cd<->ef<-><->g");
+    auto records =
+        collect(Text::split_stream(input, "<->"sv, Text::SplitBehavior::KeepEmpty, Text::Case::Sensitive, 2));
+    EXPECT_EQ(records, (std::vector<std::string>{"ab", "cd", "ef", "", "g"}));
+}
+
+TEST(StreamSplit, SameAsSplitForAnyChunkSize)
+{
+    using namespace std::literals;
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<int> letter(0, 3);
+    for (int idx = 0; idx < 200; ++idx)
+    {
+        std::string text;
+        for (int pos = static_cast<int>(gen() % 64); pos > 0; --pos)
+            text += "ab,-"[letter(gen)];
+        for (auto beh : {Text::SplitBehavior::KeepEmpty, Text::SplitBehavior::DropEmpty})
+            for (size_t chunk : {1u, 2u, 3u, 5u, 64u})
+            {
+                std::istringstream needle_input(text);
+                auto expected = Text::to_string_vector(Text::split(text, ",-"sv, beh));
+                EXPECT_EQ(collect(Text::split_stream(needle_input, ",-"sv, beh, Text::Case::Sensitive, chunk)),
+                          expected)
+                    << text << " " << chunk;
+
+                std::istringstream any_input(text);
+                expected = Text::to_string_vector(Text::split_any(text, ",-"sv, beh));
+                EXPECT_EQ(collect(Text::split_any_stream(any_input, ",-"sv, beh, Text::Case::Sensitive, chunk)),
+                          expected)
+                    << text << " " << chunk;
+            }
+    }
+}
+
+TEST(StreamSplit, CaseInsensitive)
+{
+    using namespace std::literals;
+    std::istringstream input("oneANDtwoandthree");
+    auto records = collect(Text::split_stream(input, "and"sv, Text::SplitBehavior::KeepEmpty, Text::Case::Insensitive));
+    EXPECT_EQ(records, (std::vector<std::string>{"one", "two", "three"}));
+}
+
+#if !defined(_WIN32)
+TEST(StreamSplit, FileDescriptor)
+{
+    auto path = std::filesystem::temp_directory_path() / "text_processing_stream_split.txt";
+    {
+        std::ofstream output(path);
+        for (int idx = 0; idx < 1000; ++idx)
+            output << "record " << idx << "\r\n";
+    }
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    ASSERT_GE(fd, 0);
+    size_t count = 0;
+    for (auto record : Text::split_stream(fd, "\r\n", Text::SplitBehavior::DropEmpty, Text::Case::Sensitive, 100))
+    {
+        EXPECT_EQ(record, "record " + std::to_string(count));
+        ++count;
+    }
+    ::close(fd);
+    std::filesystem::remove(path);
+    EXPECT_EQ(count, 1000u);
+}
+#endif
@@ -214,3 +214,48 @@ TEST(Sub, LeftEquiMid)
     auto result2 = Text::left(simple_sv, -6);
     EXPECT_EQ(result1, result2);
 }
+
+TEST(Slice, EveryNthElement)
+{
+    std::string records("ab1|cd2|ef3|gh4|");
+    auto column = Text::slice_view(records, 2, Text::End, 4);
+    static_assert(std::ranges::random_access_range<decltype(column)>);
+    EXPECT_EQ(column.size(), 4);
+    EXPECT_EQ(std::string(column.begin(), column.end()), "1234");
+    EXPECT_EQ(column[2], '3');
+    EXPECT_EQ(&column[0], records.data() + 2);
+    EXPECT_EQ(*(column.end() - 1), '4');
+    EXPECT_EQ(Text::slice(records, 2, Text::End, 4), "1234");
+}
+
+TEST(Slice, NegativeStep)
+{
+    std::string simple("0123456789");
+    EXPECT_EQ(Text::slice(simple, Text::Start, Text::End, -1), "9876543210");
+    EXPECT_EQ(Text::slice(simple, 2, -1, -3), "852");
+    EXPECT_EQ(Text::slice(simple, -4), "6789");
+    EXPECT_EQ(Text::slice(L"0123456789", 1, Text::End, -4), L"951");
+}
+
+TEST(Slice, InvalidRange)
+{
+    std::string simple("0123456789");
+    EXPECT_TRUE(Text::slice_view(simple, Text::Start, Text::End, 0).empty());
+    EXPECT_TRUE(Text::slice_view(simple, 5, 5).empty());
+    EXPECT_TRUE(Text::slice_view(simple, 7, 3).empty());
+    EXPECT_TRUE(Text::slice_view(simple, 20).empty());
+    EXPECT_TRUE(Text::slice_view(std::string()).empty());
+}
+
+TEST(Slice, SubviewAndContiguous)
+{
+    std::string simple("0123456789");
+    auto view = Text::slice_view(simple, 2, 6);
+    EXPECT_TRUE(view.contiguous());
+    EXPECT_EQ(view.view(), "2345");
+    EXPECT_FALSE(Text::slice_view(simple, 2, 6, 2).contiguous());
+    auto odd = Text::slice_view(simple, 1, Text::End, 2).subview(1, 3);
+    EXPECT_EQ(std::string(odd.begin(), odd.end()), "357");
+    auto reversed = Text::slice_view(simple, Text::Start, Text::End, -2).subview(2, 2);
+    EXPECT_EQ(std::string(reversed.begin(), reversed.end()), "53");
+}
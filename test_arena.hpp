@@ -0,0 +1,18 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+
+// Arena on a fixed buffer without an upstream resource, any allocation that does not fit into it throws
+template <size_t Size = 4096>
+struct TestArena
+{
+    std::array<std::byte, Size> buffer;
+    std::pmr::monotonic_buffer_resource resource{buffer.data(), buffer.size(), std::pmr::null_memory_resource()};
+
+    std::pmr::polymorphic_allocator<> allocator()
+    {
+        return &resource;
+    }
+};